@@ -0,0 +1,77 @@
+// shared harness of the benchmarks: warmup, best of BENCH_REPS, ns and cycles per operation
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #include <x86intrin.h>
+#endif
+
+#ifndef BENCH_WARMUP
+    #define BENCH_WARMUP (1)
+#endif
+
+#ifndef BENCH_REPS
+    #define BENCH_REPS (5)
+#endif
+
+// results are added here, so the work can't be optimized away
+static volatile size_t bench_sink;
+
+static inline double bench_now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// time stamp counter, 0 where there isn't one
+static inline uint64_t bench_cycles(void) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static inline void bench_report(const char *name, size_t nops, double ns, uint64_t cycles) {
+    printf(
+        "%-40s %10zu ops %10.2f ns/op %10.2f cycles/op\n",
+        name,
+        nops,
+        ns / nops,
+        (double)cycles / nops
+    );
+}
+
+// run @p setup, time @p body and run @p teardown, BENCH_WARMUP times untimed then BENCH_REPS times,
+// reporting the best repetition over @p nops operations, the locals are prefixed so they
+// don't shadow the caller's
+#define BENCH(name, nops, setup, body, teardown)                                         \
+    do {                                                                                 \
+        double bench_best_ns_ = 1e300, bench_t_;                                         \
+        uint64_t bench_best_cycles_ = 0, bench_c_;                                       \
+        for (int bench_rep_ = 0; bench_rep_ < BENCH_WARMUP + BENCH_REPS; bench_rep_++) { \
+            setup;                                                                       \
+            bench_c_ = bench_cycles();                                                   \
+            bench_t_ = bench_now();                                                      \
+            body;                                                                        \
+            bench_t_ = bench_now() - bench_t_;                                           \
+            bench_c_ = bench_cycles() - bench_c_;                                        \
+            teardown;                                                                    \
+            if (bench_rep_ >= BENCH_WARMUP && bench_t_ < bench_best_ns_) {               \
+                bench_best_ns_ = bench_t_;                                               \
+                bench_best_cycles_ = bench_c_;                                           \
+            }                                                                            \
+        }                                                                                \
+        bench_report(name, nops, bench_best_ns_, bench_best_cycles_);                    \
+    } while (0)
+
+#endif /* __BENCH_H__ */
\ No newline at end of file
@@ -0,0 +1,118 @@
+// allocation rate of Arena, FixedBuffer and malloc, across sizes and counts
+//
+// make bench, or cc -O2 -std=c11 -Isrc bench/bench_alloc.c src/*.c -pthread -o bench_alloc
+
+#include "bench.h"
+
+#include <string.h>
+
+#include "allocator.h"
+#include "arena.h"
+#include "fixed_buffer.h"
+#include "vec.h"
+
+static const size_t sizes[] = {16, 64, 256, 4096};
+static const size_t counts[] = {1000, 100000, 1000000};
+
+// bigger sizes get less allocations, so everything fits in the FixedBuffer
+#define MAX_BYTES (32UL << 20)
+
+// the allocations are touched, so the pages are really mapped
+#define TOUCH(p) (*(volatile char *)(p) = 1)
+
+int main(void) {
+    char name[64], *buffer;
+    size_t s, c, i, n, last, size, buffer_size;
+    void **ptrs, *p;
+    Allocator alloc;
+    Arena arena;
+    ArenaMark mark;
+    FixedBuffer fb;
+    Vec v;
+
+    ptrs = malloc(counts[sizeof(counts) / sizeof(*counts) - 1] * sizeof(*ptrs));
+    buffer_size = MAX_BYTES;
+    buffer = malloc(buffer_size);
+    memset(buffer, 0, buffer_size);
+
+    for (s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+        size = sizes[s];
+        printf("-- %zu byte allocations\n", size);
+        last = 0;
+        for (c = 0; c < sizeof(counts) / sizeof(*counts); c++) {
+            n = counts[c] * size > MAX_BYTES ? MAX_BYTES / size : counts[c];
+            if (n == last)
+                continue;
+            last = n;
+
+            snprintf(name, sizeof(name), "malloc + free %zu", n);
+            BENCH(name, n, (void)0, {
+                for (i = 0; i < n; i++) {
+                    ptrs[i] = malloc(size);
+                    TOUCH(ptrs[i]);
+                }
+                for (i = 0; i < n; i++)
+                    free(ptrs[i]);
+            }, (void)0);
+
+            snprintf(name, sizeof(name), "arena_alloc + arena_free %zu", n);
+            BENCH(name, n, arena_init(&arena), {
+                for (i = 0; i < n; i++) {
+                    p = arena_alloc(&arena, size);
+                    TOUCH(p);
+                }
+                arena_free(&arena);
+            }, (void)0);
+
+            // chunks survive the rewind, so after the warmup this is the steady state of a reused arena
+            snprintf(name, sizeof(name), "arena_alloc + arena_rewind %zu", n);
+            arena_init(&arena);
+            mark = arena_mark(&arena);
+            BENCH(name, n, (void)0, {
+                for (i = 0; i < n; i++) {
+                    p = arena_alloc(&arena, size);
+                    TOUCH(p);
+                }
+                arena_rewind(&arena, mark);
+            }, (void)0);
+            arena_free(&arena);
+
+            snprintf(name, sizeof(name), "fixedbuffer_alloc + clear %zu", n);
+            BENCH(name, n, fixedbuffer_init(&fb, buffer, buffer_size), {
+                for (i = 0; i < n; i++) {
+                    p = fixedbuffer_alloc(&fb, size);
+                    TOUCH(p);
+                }
+                fixedbuffer_clear(&fb);
+            }, (void)0);
+        }
+    }
+
+    // the same Vec workload on each allocator, through the Allocator interface
+    n = 1000000;
+    puts("-- vec_push of 1000000 ints");
+    BENCH("allocator_std", n, vec_new(&v, sizeof(int)), {
+        for (i = 0; i < n; i++)
+            vec_push(&v, &i);
+    }, { bench_sink += v.len; vec_free(&v); });
+    BENCH("arena", n, {
+        arena_init(&arena);
+        allocator_from_arena(&alloc, &arena);
+        vec_new_in(&v, sizeof(int), &alloc);
+    }, {
+        for (i = 0; i < n; i++)
+            vec_push(&v, &i);
+    }, { bench_sink += v.len; arena_free(&arena); });
+    BENCH("fixedbuffer", n, {
+        fixedbuffer_init(&fb, buffer, buffer_size);
+        allocator_from_fixedbuffer(&alloc, &fb);
+        vec_new_in(&v, sizeof(int), &alloc);
+    }, {
+        for (i = 0; i < n; i++)
+            vec_push(&v, &i);
+    }, { bench_sink += v.len; });
+
+    free(buffer);
+    free(ptrs);
+    return 0;
+}
\ No newline at end of file
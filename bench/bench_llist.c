@@ -0,0 +1,65 @@
+// LList push/pop across counts, with its own NodePool and with a shared one
+//
+// make bench, or cc -O2 -std=c11 -Isrc bench/bench_llist.c src/*.c -pthread -o bench_llist
+
+#include "bench.h"
+
+#include <stdint.h>
+
+#include "llist.h"
+#include "node_pool.h"
+
+static const size_t counts[] = {1000, 100000, 1000000};
+
+int main(void) {
+    char name[64];
+    size_t c, i, n;
+    NodePool pool;
+    LList list;
+
+    nodepool_init(&pool, sizeof(LLNode), NULL);
+    for (c = 0; c < sizeof(counts) / sizeof(*counts); c++) {
+        n = counts[c];
+        printf("-- %zu nodes\n", n);
+
+        snprintf(name, sizeof(name), "llist_push_back %zu", n);
+        BENCH(name, n, llist_init(&list), {
+            for (i = 0; i < n; i++)
+                llist_push_back(&list, (void *)(uintptr_t)i);
+        }, llist_free(&list, NULL));
+
+        snprintf(name, sizeof(name), "llist_push_front %zu", n);
+        BENCH(name, n, llist_init(&list), {
+            for (i = 0; i < n; i++)
+                llist_push_front(&list, (void *)(uintptr_t)i);
+        }, llist_free(&list, NULL));
+
+        snprintf(name, sizeof(name), "llist_pop_front %zu", n);
+        BENCH(name, n, {
+            llist_init(&list);
+            for (i = 0; i < n; i++)
+                llist_push_back(&list, (void *)(uintptr_t)i);
+        }, {
+            for (i = 0; i < n; i++)
+                bench_sink += (uintptr_t)llist_pop_front(&list);
+        }, llist_free(&list, NULL));
+
+        // nodes released by the pops are reused by the next pushes
+        snprintf(name, sizeof(name), "llist push_back/pop_front %zu", n);
+        BENCH(name, n, llist_init(&list), {
+            for (i = 0; i < n; i++) {
+                llist_push_back(&list, (void *)(uintptr_t)i);
+                if (i & 1)
+                    bench_sink += (uintptr_t)llist_pop_front(&list);
+            }
+        }, llist_free(&list, NULL));
+
+        snprintf(name, sizeof(name), "llist_push_back shared pool %zu", n);
+        BENCH(name, n, llist_init_shared(&list, &pool), {
+            for (i = 0; i < n; i++)
+                llist_push_back(&list, (void *)(uintptr_t)i);
+        }, llist_free(&list, NULL));
+    }
+    nodepool_free(&pool);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+// SStr append/cat/merge across piece sizes and counts
+//
+// make bench, or cc -O2 -std=c11 -Isrc bench/bench_sstr.c src/*.c -pthread -o bench_sstr
+
+#include "bench.h"
+
+#include <string.h>
+
+#include "sstr.h"
+
+static const size_t pieces[] = {4, 32, 256};
+static const size_t counts[] = {16, 1000, 100000};
+
+int main(void) {
+    char piece[257], name[64], *buf;
+    size_t p, c, i, n, len, buflen;
+    SStr s, src, tmp;
+
+    for (p = 0; p < sizeof(pieces) / sizeof(*pieces); p++) {
+        len = pieces[p];
+        memset(piece, 'x', len);
+        piece[len] = '\0';
+        printf("-- %zu character pieces\n", len);
+        for (c = 0; c < sizeof(counts) / sizeof(*counts); c++) {
+            n = counts[c];
+
+            snprintf(name, sizeof(name), "sstr_cat %zu", n);
+            BENCH(name, n, sstr_new(&s), {
+                for (i = 0; i < n; i++)
+                    sstr_cat(&s, piece);
+            }, { bench_sink += sstr_len(&s); sstr_free(&s); });
+
+            snprintf(name, sizeof(name), "sstr_cat_n %zu", n);
+            BENCH(name, n, sstr_new(&s), {
+                for (i = 0; i < n; i++)
+                    sstr_cat_n(&s, piece, len);
+            }, { bench_sink += sstr_len(&s); sstr_free(&s); });
+
+            snprintf(name, sizeof(name), "sstr_cat_n reserved %zu", n);
+            BENCH(name, n, sstr_new_with(&s, n * len), {
+                for (i = 0; i < n; i++)
+                    sstr_cat_n(&s, piece, len);
+            }, { bench_sink += sstr_len(&s); sstr_free(&s); });
+
+            snprintf(name, sizeof(name), "sstr_append_sstr %zu", n);
+            BENCH(name, n, { sstr_new(&s); sstr_from(&src, piece); }, {
+                for (i = 0; i < n; i++)
+                    sstr_append_sstr(&s, &src);
+            }, { bench_sink += sstr_len(&s); sstr_free(&s); sstr_free(&src); });
+
+            // sstr_merge consumes its source, so each operation builds one
+            snprintf(name, sizeof(name), "sstr_from + sstr_merge %zu", n);
+            BENCH(name, n, sstr_new(&s), {
+                for (i = 0; i < n; i++) {
+                    sstr_from(&tmp, piece);
+                    sstr_merge(&s, &tmp, ",");
+                }
+            }, { bench_sink += sstr_len(&s); sstr_free(&s); });
+
+            // baseline: memcpy into a buffer allocated once
+            snprintf(name, sizeof(name), "memcpy into malloc %zu", n);
+            BENCH(name, n, {
+                buf = malloc(n * len + 1);
+                buf[0] = '\0';
+                buflen = 0;
+            }, {
+                for (i = 0; i < n; i++) {
+                    memcpy(buf + buflen, piece, len + 1);
+                    buflen += len;
+                }
+            }, { bench_sink += buflen; free(buf); });
+        }
+    }
+    return 0;
+}
\ No newline at end of file
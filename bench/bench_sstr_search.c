@@ -0,0 +1,92 @@
+// SStr search kernels against their libc counterparts
+//
+// make bench, or cc -O2 -std=c11 -Isrc bench/bench_sstr_search.c src/*.c -pthread -o bench_sstr_search
+
+#include "bench.h"
+
+#include <string.h>
+
+#include "sstr.h"
+
+// every kernel scans the whole buffer, so the operations are its bytes
+#define BUF_SIZE (8UL << 20)
+
+// the count of matches goes to bench_sink
+#define SEARCH(name, body) BENCH(name, BUF_SIZE, result = 0, body, bench_sink += result)
+
+int main(void) {
+    char *buf;
+    SStrView v, rest;
+    size_t i, pos, result;
+    const char *p, *end;
+
+    // csv-like: short fields, a line every ~100 characters, some quotes
+    buf = malloc(BUF_SIZE + 1);
+    srand(42);
+    for (i = 0; i < BUF_SIZE; i++) {
+        int r = rand() % 100;
+        buf[i] = r == 0 ? '\n' : r < 10 ? ',' : r == 10 ? '"' : 'a' + r % 26;
+    }
+    buf[BUF_SIZE] = '\0';
+    memcpy(buf + BUF_SIZE - 16, "needle-in-stack", 15);
+    v = sstrview_from_n(buf, BUF_SIZE);
+
+    puts("-- every '\\n'");
+    SEARCH("sstrview_find_char", {
+        rest = v;
+        while ((pos = sstrview_find_char(rest, '\n')) != SSTR_NPOS) {
+            result++;
+            rest = sstrview_slice(rest, pos + 1, rest.len);
+        }
+    });
+    SEARCH("memchr", {
+        p = buf;
+        end = buf + BUF_SIZE;
+        while ((p = memchr(p, '\n', (size_t)(end - p))) != NULL) {
+            result++;
+            p++;
+        }
+    });
+    SEARCH("strchr", {
+        p = buf;
+        while ((p = strchr(p, '\n')) != NULL) {
+            result++;
+            p++;
+        }
+    });
+
+    puts("-- count '\\n'");
+    SEARCH("sstrview_count_char", { result = sstrview_count_char(v, '\n'); });
+    SEARCH("byte loop", {
+        for (i = 0; i < BUF_SIZE; i++)
+            result += buf[i] == '\n';
+    });
+
+    puts("-- every of \",\\n\\\"\"");
+    SEARCH("sstrview_find_any", {
+        rest = v;
+        while ((pos = sstrview_find_any(rest, sstrview_from(",\n\"")))
+               != SSTR_NPOS) {
+            result++;
+            rest = sstrview_slice(rest, pos + 1, rest.len);
+        }
+    });
+    SEARCH("strpbrk", {
+        p = buf;
+        while ((p = strpbrk(p, ",\n\"")) != NULL) {
+            result++;
+            p++;
+        }
+    });
+
+    puts("-- substring at the end");
+    SEARCH("sstrview_find", {
+        result = sstrview_find(v, sstrview_from("needle-in-stack"));
+    });
+    SEARCH("strstr", {
+        result = (size_t)(strstr(buf, "needle-in-stack") - buf);
+    });
+
+    free(buf);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+// Vec push/pop/insert/remove across element sizes and counts
+//
+// make bench, or cc -O2 -std=c11 -Isrc bench/bench_vec.c src/*.c -pthread -o bench_vec
+
+#include "bench.h"
+
+#include <string.h>
+
+#include "vec.h"
+
+static const size_t sizes[] = {4, 16, 64};
+static const size_t counts[] = {1000, 10000, 1000000};
+
+// insert and remove at the front are quadratic, so they get fewer elements
+#define SHIFT_MAX (10000UL)
+
+int main(void) {
+    char elem[64], name[64];
+    size_t s, c, i, n, szof;
+    Vec v;
+
+    memset(elem, 0x5a, sizeof(elem));
+    for (s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+        szof = sizes[s];
+        printf("-- %zu byte elements\n", szof);
+        for (c = 0; c < sizeof(counts) / sizeof(*counts); c++) {
+            n = counts[c];
+
+            snprintf(name, sizeof(name), "vec_push %zu", n);
+            BENCH(name, n, vec_new(&v, szof), {
+                for (i = 0; i < n; i++)
+                    vec_push(&v, elem);
+            }, { bench_sink += v.len; vec_free(&v); });
+
+            snprintf(name, sizeof(name), "vec_push reserved %zu", n);
+            BENCH(name, n, { vec_new_with(&v, szof, n); }, {
+                for (i = 0; i < n; i++)
+                    vec_push(&v, elem);
+            }, { bench_sink += v.len; vec_free(&v); });
+
+            snprintf(name, sizeof(name), "vec_pop %zu", n);
+            BENCH(name, n, {
+                vec_new_with_zeroed(&v, szof, n);
+            }, {
+                for (i = 0; i < n; i++)
+                    vec_pop(&v, elem);
+            }, { bench_sink += v.len; vec_free(&v); });
+
+            if (n > SHIFT_MAX)
+                continue;
+
+            snprintf(name, sizeof(name), "vec_insert front %zu", n);
+            BENCH(name, n, vec_new(&v, szof), {
+                for (i = 0; i < n; i++)
+                    vec_insert(&v, elem, 0);
+            }, { bench_sink += v.len; vec_free(&v); });
+
+            snprintf(name, sizeof(name), "vec_remove front %zu", n);
+            BENCH(name, n, {
+                vec_new_with_zeroed(&v, szof, n);
+            }, {
+                for (i = 0; i < n; i++)
+                    vec_remove(&v, 0, elem);
+            }, { bench_sink += v.len; vec_free(&v); });
+
+            snprintf(name, sizeof(name), "vec_swap_remove front %zu", n);
+            BENCH(name, n, {
+                vec_new_with_zeroed(&v, szof, n);
+            }, {
+                for (i = 0; i < n; i++)
+                    vec_swap_remove(&v, 0, elem);
+            }, { bench_sink += v.len; vec_free(&v); });
+        }
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "allocator.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline void *allocator_alloc(Allocator *a, size_t size, size_t align);
+extern inline void *allocator_realloc(
+    Allocator *a,
+    void *ptr,
+    size_t old_size,
+    size_t new_size,
+    size_t align
+);
+extern inline void allocator_free(Allocator *a, void *ptr, size_t size);
+
+#define ALIGN_UP(n, align) (((n) + (align) - 1) & ~((size_t)(align) - 1))
+
+static void *std_alloc(void *ctx, size_t size, size_t align) {
+    (void)ctx;
+    if (align <= ALLOCATOR_ALIGNMENT)
+        return malloc(size);
+    // aligned_alloc wants a multiple of the alignment
+    return aligned_alloc(align, ALIGN_UP(size, align));
+}
+
+static void *std_realloc(
+    void *ctx,
+    void *ptr,
+    size_t old_size,
+    size_t new_size,
+    size_t align
+) {
+    void *next;
+
+    if (align <= ALLOCATOR_ALIGNMENT)
+        return realloc(ptr, new_size);
+
+    // realloc doesn't keep the alignment
+    next = std_alloc(ctx, new_size, align);
+    if (next) {
+        memcpy(next, ptr, old_size < new_size ? old_size : new_size);
+        free(ptr);
+    }
+
+    return next;
+}
+
+static void std_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)size;
+    free(ptr);
+}
+
+Allocator allocator_std = {std_alloc, std_realloc, std_free, NULL};
+
+static void *arena_cb_alloc(void *ctx, size_t size, size_t align) {
+    return arena_alloc_aligned((Arena *)ctx, size, align);
+}
+
+static void *arena_cb_realloc(
+    void *ctx,
+    void *ptr,
+    size_t old_size,
+    size_t new_size,
+    size_t align
+) {
+    (void)old_size;
+    return arena_realloc_aligned((Arena *)ctx, new_size, ptr, align);
+}
+
+static void noop_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)ptr;
+    (void)size;
+}
+
+void allocator_from_arena(Allocator *a, Arena *arena) {
+    a->alloc = arena_cb_alloc;
+    a->realloc = arena_cb_realloc;
+    a->free = noop_free;
+    a->ctx = arena;
+}
+
+static void *fixedbuffer_cb_alloc(void *ctx, size_t size, size_t align) {
+    if (align < ALLOCATOR_ALIGNMENT)
+        align = ALLOCATOR_ALIGNMENT;
+    return fixedbuffer_alloc_aligned((FixedBuffer *)ctx, size, align);
+}
+
+static void *fixedbuffer_cb_realloc(
+    void *ctx,
+    void *ptr,
+    size_t old_size,
+    size_t new_size,
+    size_t align
+) {
+    (void)old_size;
+    if (align < ALLOCATOR_ALIGNMENT)
+        align = ALLOCATOR_ALIGNMENT;
+    return fixedbuffer_realloc_aligned(
+        (FixedBuffer *)ctx,
+        ptr,
+        new_size,
+        align
+    );
+}
+
+void allocator_from_fixedbuffer(Allocator *a, FixedBuffer *fixed_buffer) {
+    a->alloc = fixedbuffer_cb_alloc;
+    a->realloc = fixedbuffer_cb_realloc;
+    a->free = noop_free;
+    a->ctx = fixed_buffer;
+}
\ No newline at end of file
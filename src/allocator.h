@@ -0,0 +1,99 @@
+/**
+ * @file allocator.h
+ */
+
+#ifndef __ALLOCATOR_H__
+#define __ALLOCATOR_H__
+
+#include <stdlib.h>
+
+#include "arena.h"
+#include "fixed_buffer.h"
+
+/**
+ * @brief alignment every allocator guarantees, same as malloc
+ */
+#define ALLOCATOR_ALIGNMENT (2 * sizeof(void *))
+
+/**
+ * @brief allocator interface used by the containers
+ *
+ * the sizes of the previous allocations are always passed back, so the implementation doesn't need to track them.
+ * @p align is a power of 2, values up to ALLOCATOR_ALIGNMENT (including 0) request the default alignment
+ */
+typedef struct Allocator {
+    void *(*alloc)(void *ctx, size_t size, size_t align); /**< like aligned_alloc */
+    void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size, size_t align); /**< like realloc, @p old_size is the size @p ptr was allocated with */
+    void (*free)(void *ctx, void *ptr, size_t size); /**< like free, @p size is the size @p ptr was allocated with */
+    void *ctx; /**< passed as first argument to the callbacks */
+} Allocator;
+
+/**
+ * @brief default allocator, backed by malloc/realloc/free
+ */
+extern Allocator allocator_std;
+
+/**
+ * @brief allocator drawing from @p arena
+ *
+ * free is a no-op, the memory is released all at once with arena_free()
+ *
+ * @param a Allocator
+ * @param arena Arena
+ */
+void allocator_from_arena(Allocator *a, Arena *arena);
+
+/**
+ * @brief allocator drawing from @p fixed_buffer
+ *
+ * free is a no-op, the memory is released all at once with fixedbuffer_clear()
+ *
+ * @param a Allocator
+ * @param fixed_buffer FixedBuffer
+ */
+void allocator_from_fixedbuffer(Allocator *a, FixedBuffer *fixed_buffer);
+
+/**
+ * @brief allocate @p size bytes from @p a
+ *
+ * @param a Allocator
+ * @param size number of bytes
+ * @param align alignment, 0 for the default
+ * @return pointer to the allocation, or NULL
+ */
+inline void *allocator_alloc(Allocator *a, size_t size, size_t align) {
+    return a->alloc(a->ctx, size, align);
+}
+
+/**
+ * @brief resize the allocation @p ptr of @p old_size bytes to @p new_size bytes
+ *
+ * @param a Allocator
+ * @param ptr previous allocation
+ * @param old_size number of bytes @p ptr was allocated with
+ * @param new_size number of bytes requested
+ * @param align alignment, 0 for the default. must be the same @p ptr was allocated with
+ * @return pointer to the allocation, or NULL
+ */
+inline void *allocator_realloc(
+    Allocator *a,
+    void *ptr,
+    size_t old_size,
+    size_t new_size,
+    size_t align
+) {
+    return a->realloc(a->ctx, ptr, old_size, new_size, align);
+}
+
+/**
+ * @brief release the allocation @p ptr of @p size bytes
+ *
+ * @param a Allocator
+ * @param ptr allocation
+ * @param size number of bytes @p ptr was allocated with
+ */
+inline void allocator_free(Allocator *a, void *ptr, size_t size) {
+    a->free(a->ctx, ptr, size);
+}
+
+#endif /* __ALLOCATOR_H__ */
\ No newline at end of file
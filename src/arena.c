@@ -1,69 +1,208 @@
 #include "arena.h"
 
+#include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
+
+#define ARENA_GROWTH_FACTOR (2UL)
+
+#define ALIGN_UP(n, align) (((n) + (align) - 1) & ~((size_t)(align) - 1))
+
+// the memory of the chunk starts right after the header, aligned
+#define CHUNK_HEADER_SIZE ALIGN_UP(sizeof(ArenaChunk), ARENA_ALIGNMENT)
+
+static inline char *chunk_data(ArenaChunk *chunk) {
+    return ((char *)chunk) + CHUNK_HEADER_SIZE;
+}
+
+static inline char *chunk_align(ArenaChunk *chunk, size_t align) {
+    return (char *)ALIGN_UP((size_t)chunk->head, align);
+}
+
+static inline bool chunk_fits(ArenaChunk *chunk, size_t bytes, size_t align) {
+    char *allocation;
+
+    allocation = chunk_align(chunk, align);
+    return allocation <= chunk->end
+        && bytes <= (size_t)(chunk->end - allocation);
+}
+
+/**
+ * @brief push a new chunk big enough for @p bytes
+ * 
+ * spare chunks are reused when big enough.
+ * if @p bytes doesn't fit the chunk size, the chunk is made for it alone and the chunk size doesn't grow
+ * 
+ * @param arena Arena
+ * @param bytes number of bytes requested
+ * @return the new chunk
+ */
+static ArenaChunk *arena_chunk_new(Arena *arena, size_t bytes) {
+    ArenaChunk *chunk, **link;
+    size_t size;
+
+    for (link = &arena->spare; *link; link = &(*link)->next) {
+        chunk = *link;
+        if (bytes <= (size_t)(chunk->end - chunk_data(chunk))) {
+            *link = chunk->next;
+            chunk->next = arena->head;
+            chunk->head = chunk_data(chunk);
+            arena->head = chunk;
+            return chunk;
+        }
+    }
+
+    if (bytes > arena->chunk_size) {
+        size = bytes;
+    } else {
+        size = arena->chunk_size;
+        if (arena->chunk_size * ARENA_GROWTH_FACTOR <= ARENA_CHUNK_SIZE_MAX)
+            arena->chunk_size *= ARENA_GROWTH_FACTOR;
+    }
+
+    chunk = (ArenaChunk *)malloc(CHUNK_HEADER_SIZE + size);
+    if (chunk) {
+        chunk->next = arena->head;
+        chunk->head = chunk_data(chunk);
+        chunk->end = chunk->head + size;
+        arena->head = chunk;
+    }
+
+    return chunk;
+}
 
 void arena_init(Arena *arena) {
+    arena_init_with(arena, ARENA_CHUNK_SIZE);
+}
+
+void arena_init_with(Arena *arena, size_t chunk_size) {
     arena->head = NULL;
+    arena->spare = NULL;
+    arena->last = NULL;
+    arena->chunk_size = ALIGN_UP(chunk_size ? chunk_size : 1, ARENA_ALIGNMENT);
 }
 
 void *arena_alloc(Arena *arena, size_t bytes) {
-    ArenaNode *next;
+    return arena_alloc_aligned(arena, bytes, ARENA_ALIGNMENT);
+}
 
-    next = (ArenaNode *)malloc(sizeof(ArenaNode) + bytes);
-    next->next = arena->head;
-    arena->head = next;
+// bump allocation with any alignment, including lower than ARENA_ALIGNMENT
+static void *arena_bump(Arena *arena, size_t bytes, size_t align) {
+    ArenaChunk *chunk;
+    char *allocation;
+    size_t padding;
+
+    chunk = arena->head;
+    if (!chunk || !chunk_fits(chunk, bytes, align)) {
+        // chunk memory is only guaranteed to be aligned to ARENA_ALIGNMENT
+        padding = align > ARENA_ALIGNMENT ? align - ARENA_ALIGNMENT : 0;
+        if (!(chunk = arena_chunk_new(arena, bytes + padding)))
+            return NULL;
+    }
 
-    /* normally you should worry about alignment here, but from what i understand
-     * the result of malloc is already aligned
-     * and sizeof(ArenaNode) == sizeof(ArenaNode *) == sizeof(void *), which is always a good alignment */
-    return ((char *)next) + sizeof(ArenaNode);
+    allocation = chunk_align(chunk, align);
+    chunk->head = allocation + bytes;
+    arena->last = allocation;
+
+    return allocation;
+}
+
+void *arena_alloc_aligned(Arena *arena, size_t bytes, size_t align) {
+    if (align < ARENA_ALIGNMENT)
+        align = ARENA_ALIGNMENT;
+    return arena_bump(arena, bytes, align);
+}
+
+void *arena_alloc_unaligned(Arena *arena, size_t bytes) {
+    return arena_bump(arena, bytes, 1);
 }
 
 void *arena_realloc(Arena *arena, size_t bytes, void *prev_allocation) {
-    if (arena->head) {
-        ArenaNode *curr, *prev, *needle;
+    return arena_realloc_aligned(
+        arena,
+        bytes,
+        prev_allocation,
+        ARENA_ALIGNMENT
+    );
+}
 
-        needle = (ArenaNode *)(((char *)prev_allocation) - sizeof(ArenaNode));
+void *arena_realloc_aligned(
+    Arena *arena,
+    size_t bytes,
+    void *prev_allocation,
+    size_t align
+) {
+    ArenaChunk *chunk;
+    char *prev, *next;
+    size_t used;
+
+    prev = (char *)prev_allocation;
+    if (!prev)
+        return arena_alloc_aligned(arena, bytes, align);
+
+    // the last allocation always lives in the head chunk
+    chunk = arena->head;
+    if (prev == arena->last && bytes <= (size_t)(chunk->end - prev)
+        && ALIGN_UP((size_t)prev, align) == (size_t)prev) {
+        chunk->head = prev + bytes;
+        return prev;
+    }
 
-        prev = NULL;
-        curr = arena->head;
-        while (curr && curr != needle) {
-            prev = curr;
-            curr = curr->next;
-        }
+    // the size of the allocation isn't stored, but nothing past the used part of its chunk can belong to it
+    while (chunk && !(prev >= chunk_data(chunk) && prev < chunk->end))
+        chunk = chunk->next;
+    if (!chunk)
+        return NULL;
+    used = (size_t)(chunk->head - prev);
 
-        if (curr) {
-            ArenaNode *next;
+    if ((next = arena_alloc_aligned(arena, bytes, align)) != NULL)
+        memcpy(next, prev, used < bytes ? used : bytes);
 
-            next = curr->next;
-            needle = (ArenaNode *)realloc(needle, sizeof(ArenaNode) + bytes);
-            needle->next = next;
+    return next;
+}
 
-            if (prev)
-                prev->next = needle;
-            else
-                arena->head = needle;
+ArenaMark arena_mark(Arena *arena) {
+    ArenaMark mark;
 
-            return ((char *)next) + sizeof(ArenaNode);
-        }
+    mark.chunk = arena->head;
+    mark.head = arena->head ? arena->head->head : NULL;
+    // growing the current last allocation in place would cross the mark
+    arena->last = NULL;
+
+    return mark;
+}
+
+void arena_rewind(Arena *arena, ArenaMark mark) {
+    ArenaChunk *chunk;
+
+    while (arena->head != mark.chunk) {
+        chunk = arena->head;
+        arena->head = chunk->next;
+        chunk->next = arena->spare;
+        arena->spare = chunk;
     }
 
-    return NULL;
+    if (arena->head)
+        arena->head->head = mark.head;
+    // the last allocation before the mark may be rewound to again, so it stays fixed
+    arena->last = NULL;
 }
 
-void arena_free(Arena *arena) {
-    if (arena->head) {
-        ArenaNode *curr, *next;
+static void chunks_free(ArenaChunk *curr) {
+    ArenaChunk *next;
 
-        curr = arena->head;
+    while (curr) {
         next = curr->next;
-        while (next) {
-            curr = next;
-            next = next->next;
-            free(curr);
-        }
-
-        free(arena->head);
-        arena->head = NULL;
+        free(curr);
+        curr = next;
     }
+}
+
+void arena_free(Arena *arena) {
+    chunks_free(arena->head);
+    chunks_free(arena->spare);
+
+    arena->head = NULL;
+    arena->spare = NULL;
+    arena->last = NULL;
 }
\ No newline at end of file
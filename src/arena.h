@@ -1,12 +1,163 @@
+/**
+ * @file arena.h
+ */
+
 #ifndef __ARENA_H__
 #define __ARENA_H__
 
-typedef struct ArenaNode {
-    struct ArenaNode *next;
-} ArenaNode;
+#include <stdlib.h>
+
+/**
+ * @brief default size of the first chunk
+ */
+#define ARENA_CHUNK_SIZE (4096UL)
+
+/**
+ * @brief chunks stop growing past this size (unless the first one is already bigger)
+ */
+#define ARENA_CHUNK_SIZE_MAX (1UL << 20)
+
+/**
+ * @brief alignment of every allocation, same as malloc
+ */
+#define ARENA_ALIGNMENT (2 * sizeof(void *))
 
+/**
+ * @brief block of memory the allocations are carved from
+ * 
+ * the memory follows the header
+ */
+typedef struct ArenaChunk {
+    struct ArenaChunk *next; /**< the previous chunk */
+    char *head;              /**< beginning of the free space */
+    char *end;               /**< end of the chunk */
+} ArenaChunk;
+
+/**
+ * @brief bump allocator whose allocations are all released together
+ */
 typedef struct Arena {
-    ArenaNode *head;
+    ArenaChunk *head;  /**< the chunk being allocated from */
+    ArenaChunk *spare; /**< chunks released by arena_rewind(), reused before allocating new ones */
+    char *last;        /**< the last allocation, which can be resized in place */
+    size_t chunk_size; /**< size of the next chunk */
 } Arena;
 
+/**
+ * @brief save point of an Arena, see arena_mark()
+ */
+typedef struct ArenaMark {
+    ArenaChunk *chunk; /**< chunk being allocated from */
+    char *head;        /**< beginning of its free space */
+} ArenaMark;
+
+/**
+ * @brief initialize the Arena
+ *
+ * nothing is allocated until the first call to arena_alloc()
+ *
+ * @param arena Arena
+ */
+void arena_init(Arena *arena);
+
+/**
+ * @brief initialize the Arena with a custom chunk size
+ *
+ * every new chunk is twice as big as the previous one, up to ARENA_CHUNK_SIZE_MAX.
+ * allocations bigger than the chunk size get a chunk of their own
+ *
+ * @param arena Arena
+ * @param chunk_size size of the first chunk
+ */
+void arena_init_with(Arena *arena, size_t chunk_size);
+
+/**
+ * @brief allocate @p bytes from the Arena
+ *
+ * @param arena Arena
+ * @param bytes number of bytes
+ * @return pointer to the allocation
+ */
+void *arena_alloc(Arena *arena, size_t bytes);
+
+/**
+ * @brief allocate @p bytes from the Arena, aligned to @p align
+ *
+ * @param arena Arena
+ * @param bytes number of bytes
+ * @param align alignment, must be a power of 2. if lower than ARENA_ALIGNMENT, ARENA_ALIGNMENT is used
+ * @return pointer to the allocation
+ */
+void *arena_alloc_aligned(Arena *arena, size_t bytes, size_t align);
+
+/**
+ * @brief allocate @p bytes from the Arena, right after the previous allocation
+ *
+ * for bytes without alignment requirements, like strings, which are then packed without padding
+ *
+ * @param arena Arena
+ * @param bytes number of bytes
+ * @return pointer to the allocation
+ */
+void *arena_alloc_unaligned(Arena *arena, size_t bytes);
+
+/**
+ * @brief resize an allocation of the Arena
+ *
+ * if @p prev_allocation is the last allocation and there's space in its chunk, it's resized in place.
+ * otherwise a new allocation is made and the content copied
+ *
+ * @param arena Arena
+ * @param bytes number of bytes requested
+ * @param prev_allocation allocation to resize, can be NULL
+ * @return pointer to the allocation
+ */
+void *arena_realloc(Arena *arena, size_t bytes, void *prev_allocation);
+
+/**
+ * @brief resize an allocation of the Arena, keeping it aligned to @p align
+ *
+ * see arena_realloc()
+ *
+ * @param arena Arena
+ * @param bytes number of bytes requested
+ * @param prev_allocation allocation to resize, can be NULL
+ * @param align alignment, must be a power of 2. if lower than ARENA_ALIGNMENT, ARENA_ALIGNMENT is used
+ * @return pointer to the allocation
+ */
+void *arena_realloc_aligned(
+    Arena *arena,
+    size_t bytes,
+    void *prev_allocation,
+    size_t align
+);
+
+/**
+ * @brief save the current state of the Arena
+ *
+ * the allocations made before the mark can't be resized in place anymore, so they can't grow past it
+ *
+ * @param arena Arena
+ * @return the mark, to be passed to arena_rewind()
+ */
+ArenaMark arena_mark(Arena *arena);
+
+/**
+ * @brief release every allocation made after @p mark was taken
+ *
+ * the chunks emptied are kept for the next allocations instead of being freed.
+ * marks taken after @p mark become invalid, as do all marks after arena_free()
+ *
+ * @param arena Arena
+ * @param mark return of arena_mark()
+ */
+void arena_rewind(Arena *arena, ArenaMark mark);
+
+/**
+ * @brief release all the allocations of the Arena
+ *
+ * @param arena Arena
+ */
+void arena_free(Arena *arena);
+
 #endif /* __ARENA_H__ */
\ No newline at end of file
@@ -0,0 +1,328 @@
+#include "bitset.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the bulk operations and the popcount use AVX2 when the cpu has it, picked at runtime
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define BITSET_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+#define WORD_BITS (64)
+
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline void bitset_set_growth(Bitset *b, Growth growth);
+extern inline size_t bitset_len(Bitset *b);
+extern inline uint64_t *bitset_words(Bitset *b);
+extern inline bool bitset_test(Bitset *b, size_t pos);
+extern inline void bitset_set(Bitset *b, size_t pos);
+extern inline void bitset_clear(Bitset *b, size_t pos);
+extern inline void bitset_assign(Bitset *b, size_t pos, bool val);
+
+static inline size_t nwords(size_t nbits) {
+    return (nbits + WORD_BITS - 1) / WORD_BITS;
+}
+
+static inline unsigned popcount64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_popcountll(w);
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ull);
+    w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+    w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return (unsigned)((w * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+static inline unsigned ctz64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(w);
+#else
+    unsigned n;
+
+    for (n = 0; !(w & 1); n++)
+        w >>= 1;
+    return n;
+#endif
+}
+
+// zero the bits past len in the last word
+static inline void mask_tail(Bitset *b) {
+    uint64_t *words;
+
+    if (b->len % WORD_BITS) {
+        words = (uint64_t *)b->words.ptr;
+        words[b->len / WORD_BITS] &= ((uint64_t)1 << (b->len % WORD_BITS)) - 1;
+    }
+}
+
+/********************************************************************************************
+ *                                         SCALAR                                           *
+ ********************************************************************************************/
+
+static size_t count_scalar(const uint64_t *w, size_t n) {
+    size_t i, count;
+
+    count = 0;
+    for (i = 0; i < n; i++)
+        count += popcount64(w[i]);
+    return count;
+}
+
+static void and_scalar(uint64_t *dst, const uint64_t *src, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        dst[i] &= src[i];
+}
+
+static void or_scalar(uint64_t *dst, const uint64_t *src, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        dst[i] |= src[i];
+}
+
+static void xor_scalar(uint64_t *dst, const uint64_t *src, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        dst[i] ^= src[i];
+}
+
+static void andnot_scalar(uint64_t *dst, const uint64_t *src, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        dst[i] &= ~src[i];
+}
+
+/********************************************************************************************
+ *                                          AVX2                                            *
+ ********************************************************************************************/
+
+#ifdef BITSET_SIMD_X86
+
+#define AVX2 __attribute__((target("avx2,popcnt")))
+
+// nibble lookup popcount (Mula), summed per 64 bit lane with sad
+AVX2 static size_t count_avx2(const uint64_t *w, size_t n) {
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i acc, v, cnt;
+    size_t i, count;
+
+    acc = _mm256_setzero_si256();
+    for (i = 0; i + 4 <= n; i += 4) {
+        v = _mm256_loadu_si256((const __m256i *)(w + i));
+        cnt = _mm256_add_epi8(
+            _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low)),
+            _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+    }
+    count = (size_t)_mm256_extract_epi64(acc, 0) + (size_t)_mm256_extract_epi64(acc, 1)
+        + (size_t)_mm256_extract_epi64(acc, 2) + (size_t)_mm256_extract_epi64(acc, 3);
+    for (; i < n; i++)
+        count += (size_t)__builtin_popcountll(w[i]);
+    return count;
+}
+
+#define DEFINE_BULK_AVX2(name, vop, op)                                           \
+    AVX2 static void name(uint64_t *dst, const uint64_t *src, size_t n) {         \
+        __m256i d, s;                                                             \
+        size_t i;                                                                 \
+                                                                                  \
+        for (i = 0; i + 4 <= n; i += 4) {                                         \
+            d = _mm256_loadu_si256((const __m256i *)(dst + i));                   \
+            s = _mm256_loadu_si256((const __m256i *)(src + i));                   \
+            _mm256_storeu_si256((__m256i *)(dst + i), vop);                       \
+        }                                                                         \
+        for (; i < n; i++)                                                        \
+            dst[i] = op;                                                          \
+    }
+
+DEFINE_BULK_AVX2(and_avx2, _mm256_and_si256(d, s), dst[i] & src[i])
+DEFINE_BULK_AVX2(or_avx2, _mm256_or_si256(d, s), dst[i] | src[i])
+DEFINE_BULK_AVX2(xor_avx2, _mm256_xor_si256(d, s), dst[i] ^ src[i])
+DEFINE_BULK_AVX2(andnot_avx2, _mm256_andnot_si256(s, d), dst[i] & ~src[i])
+
+static inline bool has_avx2(void) {
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif /* BITSET_SIMD_X86 */
+
+static size_t count_words(const uint64_t *w, size_t n) {
+#ifdef BITSET_SIMD_X86
+    if (has_avx2())
+        return count_avx2(w, n);
+#endif
+    return count_scalar(w, n);
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void bitset_new(Bitset *b) {
+    bitset_new_in(b, NULL);
+}
+
+void bitset_new_in(Bitset *b, Allocator *alloc) {
+    vec_new_in(&b->words, sizeof(uint64_t), alloc);
+    b->len = 0;
+}
+
+void bitset_new_with(Bitset *b, size_t nbits) {
+    bitset_new(b);
+    bitset_resize(b, nbits);
+}
+
+void bitset_free(Bitset *b) {
+    vec_free(&b->words);
+    b->len = 0;
+}
+
+void bitset_resize(Bitset *b, size_t nbits) {
+    size_t old, n;
+
+    old = b->words.len;
+    n = nwords(nbits);
+    if (n > old) {
+        vec_reserve(&b->words, n);
+        memset((uint64_t *)b->words.ptr + old, 0, (n - old) * sizeof(uint64_t));
+    }
+    b->words.len = n;
+    b->len = nbits;
+    mask_tail(b);
+}
+
+void bitset_push(Bitset *b, bool val) {
+    uint64_t zero;
+
+    if (b->len % WORD_BITS == 0) {
+        zero = 0;
+        vec_push(&b->words, &zero);
+    }
+    b->len++;
+    if (val)
+        bitset_set(b, b->len - 1);
+}
+
+void bitset_fill(Bitset *b, bool val) {
+    memset(b->words.ptr, val ? 0xff : 0, b->words.len * sizeof(uint64_t));
+    mask_tail(b);
+}
+
+size_t bitset_count(Bitset *b) {
+    return count_words((const uint64_t *)b->words.ptr, b->words.len);
+}
+
+size_t bitset_rank(Bitset *b, size_t pos) {
+    const uint64_t *words;
+    size_t count;
+
+    if (pos > b->len)
+        pos = b->len;
+    words = (const uint64_t *)b->words.ptr;
+    count = count_words(words, pos / WORD_BITS);
+    if (pos % WORD_BITS)
+        count += popcount64(words[pos / WORD_BITS] & (((uint64_t)1 << (pos % WORD_BITS)) - 1));
+    return count;
+}
+
+size_t bitset_select(Bitset *b, size_t k) {
+    const uint64_t *words;
+    uint64_t w;
+    size_t i;
+    unsigned cnt;
+
+    words = (const uint64_t *)b->words.ptr;
+    for (i = 0; i < b->words.len; i++) {
+        w = words[i];
+        cnt = popcount64(w);
+        if (k < cnt) {
+            // drop the k lowest set bits, the answer is the next one
+            while (k--)
+                w &= w - 1;
+            return i * WORD_BITS + ctz64(w);
+        }
+        k -= cnt;
+    }
+    return BITSET_NPOS;
+}
+
+size_t bitset_find_next_set(Bitset *b, size_t pos) {
+    const uint64_t *words;
+    uint64_t w;
+    size_t i;
+
+    if (pos >= b->len)
+        return BITSET_NPOS;
+    words = (const uint64_t *)b->words.ptr;
+    i = pos / WORD_BITS;
+    w = words[i] & (~(uint64_t)0 << (pos % WORD_BITS));
+    while (!w) {
+        if (++i >= b->words.len)
+            return BITSET_NPOS;
+        w = words[i];
+    }
+    return i * WORD_BITS + ctz64(w);
+}
+
+void bitset_and(Bitset *dst, Bitset *src) {
+    size_t n;
+
+    n = dst->words.len < src->words.len ? dst->words.len : src->words.len;
+#ifdef BITSET_SIMD_X86
+    if (has_avx2())
+        and_avx2((uint64_t *)dst->words.ptr, (const uint64_t *)src->words.ptr, n);
+    else
+#endif
+        and_scalar((uint64_t *)dst->words.ptr, (const uint64_t *)src->words.ptr, n);
+    if (dst->words.len > n)
+        memset((uint64_t *)dst->words.ptr + n, 0, (dst->words.len - n) * sizeof(uint64_t));
+}
+
+void bitset_or(Bitset *dst, Bitset *src) {
+    size_t n;
+
+    n = dst->words.len < src->words.len ? dst->words.len : src->words.len;
+#ifdef BITSET_SIMD_X86
+    if (has_avx2())
+        or_avx2((uint64_t *)dst->words.ptr, (const uint64_t *)src->words.ptr, n);
+    else
+#endif
+        or_scalar((uint64_t *)dst->words.ptr, (const uint64_t *)src->words.ptr, n);
+    mask_tail(dst);
+}
+
+void bitset_xor(Bitset *dst, Bitset *src) {
+    size_t n;
+
+    n = dst->words.len < src->words.len ? dst->words.len : src->words.len;
+#ifdef BITSET_SIMD_X86
+    if (has_avx2())
+        xor_avx2((uint64_t *)dst->words.ptr, (const uint64_t *)src->words.ptr, n);
+    else
+#endif
+        xor_scalar((uint64_t *)dst->words.ptr, (const uint64_t *)src->words.ptr, n);
+    mask_tail(dst);
+}
+
+void bitset_andnot(Bitset *dst, Bitset *src) {
+    size_t n;
+
+    n = dst->words.len < src->words.len ? dst->words.len : src->words.len;
+#ifdef BITSET_SIMD_X86
+    if (has_avx2())
+        andnot_avx2((uint64_t *)dst->words.ptr, (const uint64_t *)src->words.ptr, n);
+    else
+#endif
+        andnot_scalar((uint64_t *)dst->words.ptr, (const uint64_t *)src->words.ptr, n);
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+/**
+ * @file bitset.h
+ */
+
+#ifndef __BITSET_H__
+#define __BITSET_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+#include "growth.h"
+#include "vec.h"
+
+/**
+ * @brief returned when no bit is found
+ */
+#define BITSET_NPOS ((size_t)-1)
+
+/**
+ * @brief growable array of bits, packed in 64 bit words
+ *
+ * the words are the elements of a Vec, so the Bitset grows with the Vec's Growth policy.
+ * the bits past len in the last word are always 0
+ */
+typedef struct Bitset {
+    Vec words;  /**< the words, bit i is bit i % 64 of word i / 64 */
+    size_t len; /**< number of bits */
+} Bitset;
+
+/**
+ * @brief new empty Bitset
+ *
+ * @param b Bitset
+ */
+void bitset_new(Bitset *b);
+
+/**
+ * @brief new empty Bitset, using @p alloc for its memory
+ *
+ * @param b Bitset
+ * @param alloc Allocator, NULL for allocator_std
+ */
+void bitset_new_in(Bitset *b, Allocator *alloc);
+
+/**
+ * @brief new Bitset of @p nbits bits, all 0
+ *
+ * @param b Bitset
+ * @param nbits number of bits
+ */
+void bitset_new_with(Bitset *b, size_t nbits);
+
+/**
+ * @brief release memory
+ *
+ * @param b Bitset
+ */
+void bitset_free(Bitset *b);
+
+/**
+ * @brief change the number of bits, the new ones are 0
+ *
+ * @param b Bitset
+ * @param nbits number of bits
+ */
+void bitset_resize(Bitset *b, size_t nbits);
+
+/**
+ * @brief change how the Bitset grows
+ *
+ * @param b Bitset
+ * @param growth Growth policy, GROWTH_2X by default
+ */
+inline void bitset_set_growth(Bitset *b, Growth growth) {
+    vec_set_growth(&b->words, growth);
+}
+
+/**
+ * @brief number of bits
+ *
+ * @param b Bitset
+ * @return length
+ */
+inline size_t bitset_len(Bitset *b) {
+    return b->len;
+}
+
+/**
+ * @brief the words, for loops over the whole Bitset
+ *
+ * @param b Bitset
+ * @return pointer to the first word, (len + 63) / 64 of them
+ */
+inline uint64_t *bitset_words(Bitset *b) {
+    return (uint64_t *)b->words.ptr;
+}
+
+/**
+ * @brief if bit @p pos is 1
+ *
+ * @param b Bitset
+ * @param pos index of the bit
+ * @return boolean, false if out of bounds
+ */
+inline bool bitset_test(Bitset *b, size_t pos) {
+    if (pos < b->len)
+        return (((uint64_t *)b->words.ptr)[pos >> 6] >> (pos & 63)) & 1;
+    return false;
+}
+
+/**
+ * @brief set bit @p pos to 1
+ *
+ * @param b Bitset
+ * @param pos index of the bit
+ */
+inline void bitset_set(Bitset *b, size_t pos) {
+    if (pos < b->len)
+        ((uint64_t *)b->words.ptr)[pos >> 6] |= (uint64_t)1 << (pos & 63);
+}
+
+/**
+ * @brief set bit @p pos to 0
+ *
+ * @param b Bitset
+ * @param pos index of the bit
+ */
+inline void bitset_clear(Bitset *b, size_t pos) {
+    if (pos < b->len)
+        ((uint64_t *)b->words.ptr)[pos >> 6] &= ~((uint64_t)1 << (pos & 63));
+}
+
+/**
+ * @brief set bit @p pos to @p val
+ *
+ * @param b Bitset
+ * @param pos index of the bit
+ * @param val value of the bit
+ */
+inline void bitset_assign(Bitset *b, size_t pos, bool val) {
+    if (val)
+        bitset_set(b, pos);
+    else
+        bitset_clear(b, pos);
+}
+
+/**
+ * @brief append a bit
+ *
+ * @param b Bitset
+ * @param val value of the bit
+ */
+void bitset_push(Bitset *b, bool val);
+
+/**
+ * @brief set all the bits to @p val
+ *
+ * @param b Bitset
+ * @param val value of the bits
+ */
+void bitset_fill(Bitset *b, bool val);
+
+/**
+ * @brief number of bits set to 1
+ *
+ * @param b Bitset
+ * @return popcount
+ */
+size_t bitset_count(Bitset *b);
+
+/**
+ * @brief number of bits set to 1 before @p pos
+ *
+ * @param b Bitset
+ * @param pos index of the bit, clamped to the length
+ * @return rank
+ */
+size_t bitset_rank(Bitset *b, size_t pos);
+
+/**
+ * @brief index of the bit set to 1 with rank @p k, the k-th starting from 0
+ *
+ * @param b Bitset
+ * @param k rank searched
+ * @return index of the bit, BITSET_NPOS if there are less than @p k + 1 bits set
+ */
+size_t bitset_select(Bitset *b, size_t k);
+
+/**
+ * @brief index of the first bit set to 1 starting from @p pos
+ *
+ * e.g. `for (i = bitset_find_next_set(b, 0); i != BITSET_NPOS; i = bitset_find_next_set(b, i + 1))`
+ *
+ * @param b Bitset
+ * @param pos index to start from
+ * @return index of the bit, BITSET_NPOS if not found
+ */
+size_t bitset_find_next_set(Bitset *b, size_t pos);
+
+/**
+ * @brief @p dst &= @p src
+ *
+ * the length of @p dst doesn't change, missing bits of @p src count as 0
+ *
+ * @param dst Bitset
+ * @param src Bitset
+ */
+void bitset_and(Bitset *dst, Bitset *src);
+
+/**
+ * @brief @p dst |= @p src
+ *
+ * the length of @p dst doesn't change, missing bits of @p src count as 0
+ *
+ * @param dst Bitset
+ * @param src Bitset
+ */
+void bitset_or(Bitset *dst, Bitset *src);
+
+/**
+ * @brief @p dst ^= @p src
+ *
+ * the length of @p dst doesn't change, missing bits of @p src count as 0
+ *
+ * @param dst Bitset
+ * @param src Bitset
+ */
+void bitset_xor(Bitset *dst, Bitset *src);
+
+/**
+ * @brief @p dst &= ~@p src
+ *
+ * the length of @p dst doesn't change, missing bits of @p src count as 0
+ *
+ * @param dst Bitset
+ * @param src Bitset
+ */
+void bitset_andnot(Bitset *dst, Bitset *src);
+
+#endif /* __BITSET_H__ */
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "deque.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline void deque_truncate(Deque *d);
+extern inline void deque_set_growth(Deque *d, Growth growth);
+extern inline size_t deque_len(Deque *d);
+extern inline bool deque_is_empty(Deque *d);
+extern inline void *deque_at(Deque *d, size_t pos);
+extern inline void deque_push_back(Deque *d, void *elem);
+extern inline bool deque_pop_front(Deque *d, void *elem);
+
+static inline char *deque_ptr(Deque *d, size_t pos) {
+    return ((char *)d->vec.ptr) + (pos * d->vec.szof);
+}
+
+void deque_new(Deque *d, size_t szof) {
+    deque_new_in(d, szof, NULL);
+}
+
+void deque_new_in(Deque *d, size_t szof, Allocator *alloc) {
+    vec_new_in(&d->vec, szof, alloc);
+    d->head = 0;
+}
+
+void deque_free(Deque *d) {
+    vec_free(&d->vec);
+    d->head = 0;
+}
+
+void deque_reserve(Deque *d, size_t nelem) {
+    size_t old_cap, wrapped, tail;
+
+    old_cap = d->vec.cap;
+    if (nelem <= old_cap)
+        return;
+    vec_reserve(&d->vec, nelem);
+
+    // the realloc kept the storage as it was, so the wrapped elements need to be moved
+    if (d->head + d->vec.len > old_cap) {
+        wrapped = d->head + d->vec.len - old_cap;
+        tail = old_cap - d->head;
+        if (wrapped <= d->vec.cap - old_cap && wrapped <= tail) {
+            // the beginning of the storage goes after the old end
+            vec_memcpy(&d->vec, deque_ptr(d, old_cap), d->vec.ptr, wrapped);
+        } else {
+            // the elements up to the old end go to the new end
+            vec_memmove(
+                &d->vec,
+                deque_ptr(d, d->vec.cap - tail),
+                deque_ptr(d, d->head),
+                tail
+            );
+            d->head = d->vec.cap - tail;
+        }
+    }
+}
+
+void deque_push_front(Deque *d, void *elem) {
+    if (d->vec.len == d->vec.cap)
+        deque_reserve(d, d->vec.len + 1);
+    d->head = d->head ? d->head - 1 : d->vec.cap - 1;
+    vec_memcpy(&d->vec, deque_ptr(d, d->head), elem, 1);
+    d->vec.len++;
+}
+
+bool deque_pop_back(Deque *d, void *elem) {
+    size_t pos;
+
+    if (!d->vec.len)
+        return false;
+    d->vec.len--;
+    if (elem) {
+        pos = d->head + d->vec.len;
+        if (pos >= d->vec.cap)
+            pos -= d->vec.cap;
+        vec_memcpy(&d->vec, elem, deque_ptr(d, pos), 1);
+    }
+    return true;
+}
+
+void deque_push_n(Deque *d, void *elems, size_t nelem) {
+    size_t pos, first;
+
+    if (!nelem)
+        return;
+    deque_reserve(d, d->vec.len + nelem);
+
+    pos = d->head + d->vec.len;
+    if (pos >= d->vec.cap)
+        pos -= d->vec.cap;
+    first = d->vec.cap - pos < nelem ? d->vec.cap - pos : nelem;
+    vec_memcpy(&d->vec, deque_ptr(d, pos), elems, first);
+    vec_memcpy(
+        &d->vec,
+        d->vec.ptr,
+        ((char *)elems) + (first * d->vec.szof),
+        nelem - first
+    );
+    d->vec.len += nelem;
+}
+
+size_t deque_pop_n(Deque *d, void *elems, size_t nelem) {
+    size_t first;
+
+    if (nelem > d->vec.len)
+        nelem = d->vec.len;
+    if (!nelem)
+        return 0;
+
+    first = d->vec.cap - d->head < nelem ? d->vec.cap - d->head : nelem;
+    if (elems) {
+        vec_memcpy(&d->vec, elems, deque_ptr(d, d->head), first);
+        vec_memcpy(
+            &d->vec,
+            ((char *)elems) + (first * d->vec.szof),
+            d->vec.ptr,
+            nelem - first
+        );
+    }
+    d->head += nelem;
+    if (d->head >= d->vec.cap)
+        d->head -= d->vec.cap;
+    d->vec.len -= nelem;
+
+    return nelem;
+}
\ No newline at end of file
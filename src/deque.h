@@ -0,0 +1,198 @@
+/**
+ * @file deque.h
+ */
+
+#ifndef __DEQUE_H__
+#define __DEQUE_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "allocator.h"
+#include "vec.h"
+
+/**
+ * @brief double-ended queue, a ring buffer over a Vec's storage
+ *
+ * the Vec's len is the number of elements, which start at head and wrap around at cap.
+ * pushing and popping at both ends is O(1), the memory grows with the Vec's machinery
+ */
+typedef struct Deque {
+    Vec vec;     /**< storage, its len is the Deque's */
+    size_t head; /**< index in the storage of the first element */
+} Deque;
+
+/**
+ * @brief new Deque
+ *
+ * @param d Deque
+ * @param szof size of the single elements it's going to contain
+ */
+void deque_new(Deque *d, size_t szof);
+
+/**
+ * @brief new Deque, using @p alloc for its memory
+ *
+ * @param d Deque
+ * @param szof size of the single elements it's going to contain
+ * @param alloc Allocator, NULL for allocator_std
+ */
+void deque_new_in(Deque *d, size_t szof, Allocator *alloc);
+
+/**
+ * @brief release memory
+ *
+ * if the single elements own memory, that needs to be release before by the caller
+ *
+ * @param d Deque
+ */
+void deque_free(Deque *d);
+
+/**
+ * @brief empty the Deque but don't free the memory, so it can be reused
+ *
+ * @param d Deque
+ */
+inline void deque_truncate(Deque *d) {
+    d->vec.len = 0;
+    d->head = 0;
+}
+
+/**
+ * @brief change how the Deque grows
+ *
+ * @param d Deque
+ * @param growth Growth policy, GROWTH_2X by default
+ */
+inline void deque_set_growth(Deque *d, Growth growth) {
+    vec_set_growth(&d->vec, growth);
+}
+
+/**
+ * @brief reserve memory ahead of time
+ *
+ * @param d Deque
+ * @param nelem number of elements to reserve memory for
+ */
+void deque_reserve(Deque *d, size_t nelem);
+
+/**
+ * @brief number of elements
+ *
+ * @param d Deque
+ * @return length
+ */
+inline size_t deque_len(Deque *d) {
+    return d->vec.len;
+}
+
+/**
+ * @brief if Deque is empty
+ *
+ * @param d Deque
+ * @return boolean
+ */
+inline bool deque_is_empty(Deque *d) {
+    return d->vec.len == 0;
+}
+
+/**
+ * @brief return pointer to element at pos, counting from the front
+ *
+ * if changes to the Deque are made, this pointer can become invalid
+ *
+ * @param d Deque
+ * @param pos index of the element
+ * @return pointer to element, NULL if out of bounds
+ */
+inline void *deque_at(Deque *d, size_t pos) {
+    if (pos >= d->vec.len)
+        return NULL;
+    pos += d->head;
+    if (pos >= d->vec.cap)
+        pos -= d->vec.cap;
+    return ((char *)d->vec.ptr) + (pos * d->vec.szof);
+}
+
+/**
+ * @brief insert element at the end through shallow-copy
+ *
+ * @param d Deque
+ * @param elem element to insert
+ */
+inline void deque_push_back(Deque *d, void *elem) {
+    size_t pos;
+
+    if (d->vec.len == d->vec.cap)
+        deque_reserve(d, d->vec.len + 1);
+    pos = d->head + d->vec.len;
+    if (pos >= d->vec.cap)
+        pos -= d->vec.cap;
+    memcpy(((char *)d->vec.ptr) + (pos * d->vec.szof), elem, d->vec.szof);
+    d->vec.len++;
+}
+
+/**
+ * @brief insert element at the beginning through shallow-copy
+ *
+ * @param d Deque
+ * @param elem element to insert
+ */
+void deque_push_front(Deque *d, void *elem);
+
+/**
+ * @brief remove element from the beginning
+ *
+ * if the element owns memory, that needs to be freed through @p elem
+ *
+ * @param d Deque
+ * @param elem element removed, can be NULL
+ * @return false if the Deque was empty
+ */
+inline bool deque_pop_front(Deque *d, void *elem) {
+    if (!d->vec.len)
+        return false;
+    if (elem)
+        memcpy(elem, ((char *)d->vec.ptr) + (d->head * d->vec.szof), d->vec.szof);
+    if (++d->head == d->vec.cap)
+        d->head = 0;
+    d->vec.len--;
+    return true;
+}
+
+/**
+ * @brief remove element from the end
+ *
+ * if the element owns memory, that needs to be freed through @p elem
+ *
+ * @param d Deque
+ * @param elem element removed, can be NULL
+ * @return false if the Deque was empty
+ */
+bool deque_pop_back(Deque *d, void *elem);
+
+/**
+ * @brief bulk insert of elements at the end through shallow-copy
+ *
+ * copies in at most two segments
+ *
+ * @param d Deque
+ * @param elems array of elements
+ * @param nelem number of elements of the array
+ */
+void deque_push_n(Deque *d, void *elems, size_t nelem);
+
+/**
+ * @brief bulk remove of elements from the beginning
+ *
+ * copies out in at most two segments
+ *
+ * @param d Deque
+ * @param elems where to copy the elements removed, can be NULL
+ * @param nelem maximum number of elements to remove
+ * @return number of elements removed
+ */
+size_t deque_pop_n(Deque *d, void *elems, size_t nelem);
+
+#endif /* __DEQUE_H__ */
\ No newline at end of file
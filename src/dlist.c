@@ -0,0 +1,165 @@
+#include "dlist.h"
+
+#include <stdlib.h>
+
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline bool dlist_is_empty(DList *list);
+
+static inline NodePool *dlist_pool(DList *list) {
+    return list->shared ? list->shared : &list->pool;
+}
+
+static DLNode *dlnode_new(DList *list, void *data) {
+    DLNode *node;
+
+    node = nodepool_alloc(dlist_pool(list));
+    node->data = data;
+    node->next = NULL;
+    node->prev = NULL;
+
+    return node;
+}
+
+static inline void
+dlnode_free(DList *list, DLNode *node, Func_Free func_free) {
+    if (func_free)
+        func_free(node->data);
+    nodepool_release(dlist_pool(list), node);
+}
+
+// detach @p node from the list, without freeing it
+static void dlist_unlink(DList *list, DLNode *node) {
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        list->head = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        list->tail = node->prev;
+    node->next = node->prev = NULL;
+}
+
+// attach a detached @p node after @p prev, at the beginning if @p prev is NULL
+static void dlist_link(DList *list, DLNode *prev, DLNode *node) {
+    node->prev = prev;
+    node->next = prev ? prev->next : list->head;
+    if (node->next)
+        node->next->prev = node;
+    else
+        list->tail = node;
+    if (prev)
+        prev->next = node;
+    else
+        list->head = node;
+}
+
+void dlist_init(DList *list) {
+    dlist_init_in(list, NULL);
+}
+
+void dlist_init_in(DList *list, Allocator *alloc) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->alloc = alloc ? alloc : &allocator_std;
+    nodepool_init(&list->pool, sizeof(DLNode), list->alloc);
+    list->shared = NULL;
+}
+
+void dlist_init_shared(DList *list, NodePool *pool) {
+    dlist_init_in(list, pool->alloc);
+    list->shared = pool;
+}
+
+void dlist_free(DList *list, Func_Free func_free) {
+    DLNode *curr, *next;
+
+    if (!list->shared) {
+        if (func_free)
+            for (curr = list->head; curr; curr = curr->next)
+                func_free(curr->data);
+        nodepool_free(&list->pool);
+    } else {
+        for (curr = list->head; curr; curr = next) {
+            next = curr->next;
+            dlnode_free(list, curr, func_free);
+        }
+    }
+    list->head = list->tail = NULL;
+}
+
+DLNode *dlist_next(DList *list, DLNode *curr) {
+    if (curr)
+        return curr->next;
+    else
+        return list->head;
+}
+
+DLNode *dlist_prev(DList *list, DLNode *curr) {
+    if (curr)
+        return curr->prev;
+    else
+        return list->tail;
+}
+
+DLNode *dlist_push_back(DList *list, void *data) {
+    DLNode *node;
+
+    node = dlnode_new(list, data);
+    dlist_link(list, list->tail, node);
+
+    return node;
+}
+
+DLNode *dlist_push_front(DList *list, void *data) {
+    DLNode *node;
+
+    node = dlnode_new(list, data);
+    dlist_link(list, NULL, node);
+
+    return node;
+}
+
+DLNode *dlist_insert(DList *list, DLNode *prev, void *data) {
+    DLNode *node;
+
+    node = dlnode_new(list, data);
+    dlist_link(list, prev, node);
+
+    return node;
+}
+
+void *dlist_pop_back(DList *list) {
+    return dlist_remove(list, list->tail);
+}
+
+void *dlist_pop_front(DList *list) {
+    return dlist_remove(list, list->head);
+}
+
+void *dlist_remove(DList *list, DLNode *node) {
+    void *data;
+
+    if (!node)
+        return NULL;
+
+    data = node->data;
+    dlist_unlink(list, node);
+    dlnode_free(list, node, NULL);
+
+    return data;
+}
+
+void dlist_move_front(DList *list, DLNode *node) {
+    if (list->head != node) {
+        dlist_unlink(list, node);
+        dlist_link(list, NULL, node);
+    }
+}
+
+void dlist_move_back(DList *list, DLNode *node) {
+    if (list->tail != node) {
+        dlist_unlink(list, node);
+        dlist_link(list, list->tail, node);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+/**
+ * @file dlist.h
+ */
+
+#ifndef __DLIST_H__
+#define __DLIST_H__
+
+#include <stdbool.h>
+
+#include "allocator.h"
+#include "llist.h"
+#include "node_pool.h"
+
+/**
+ * @brief doubly linked list's node
+ */
+typedef struct DLNode {
+    void *data;             /**< the node's data */
+    struct DLNode *next;    /**< the next node */
+    struct DLNode *prev;    /**< the previous node */
+} DLNode;
+
+/**
+ * @brief doubly linked list
+ *
+ * like LList, but every node links its predecessor too, so going backwards and removing are O(1)
+ *
+ * the nodes come from a NodePool, the list's own or one shared with other lists
+ */
+typedef struct DList {
+    DLNode *head;     /**< beginning of the list */
+    DLNode *tail;     /**< end of the list */
+    Allocator *alloc; /**< where the blocks of nodes come from */
+    NodePool pool;    /**< the list's own nodes */
+    NodePool *shared; /**< pool shared with other lists, NULL for the list's own */
+} DList;
+
+/**
+ * @brief initialize the list
+ *
+ * @param list doubly linked list
+ */
+void dlist_init(DList *list);
+
+/**
+ * @brief initialize the list, with nodes coming from @p alloc
+ *
+ * @param list doubly linked list
+ * @param alloc Allocator, if NULL allocator_std
+ */
+void dlist_init_in(DList *list, Allocator *alloc);
+
+/**
+ * @brief initialize the list, with nodes coming from @p pool
+ *
+ * the pool is shared with other lists, so dlist_free() gives the nodes back one by one
+ *
+ * @param list doubly linked list
+ * @param pool NodePool, with nodes of at least sizeof(DLNode)
+ */
+void dlist_init_shared(DList *list, NodePool *pool);
+
+/**
+ * @brief free the list
+ * 
+ * won't free the nodes's data, only the list, if @p func_free is NULL.
+ * with the list's own pool, the blocks of nodes are released all at once
+ *
+ * @param list doubly linked list
+ * @param func_free callback to free the nodes's data
+ */
+void dlist_free(DList *list, Func_Free func_free);
+
+/**
+ * @brief return the node after @p curr
+ *
+ * if @p curr == NULL, returns the first node
+ * 
+ * @param list doubly linked list
+ * @param curr current node
+ * @return the next node
+ */
+DLNode *dlist_next(DList *list, DLNode *curr);
+
+/**
+ * @brief return the node before @p curr
+ *
+ * if @p curr == NULL, returns the last node
+ * 
+ * @param list doubly linked list
+ * @param curr current node
+ * @return the previous node
+ */
+DLNode *dlist_prev(DList *list, DLNode *curr);
+
+/**
+ * @brief insert node at the end of the list
+ *
+ * @param list doubly linked list
+ * @param data node's data
+ * @return the node inserted
+ */
+DLNode *dlist_push_back(DList *list, void *data);
+
+/**
+ * @brief insert node at the beginning of the list
+ *
+ * @param list doubly linked list
+ * @param data node's data
+ * @return the node inserted
+ */
+DLNode *dlist_push_front(DList *list, void *data);
+
+/**
+ * @brief insert node after @p prev
+ * 
+ * if @p prev is NULL, insert at the beginning of the list
+ *
+ * @param list doubly linked list
+ * @param prev node before the one to be inserted
+ * @param data node's data
+ * @return the node inserted
+ */
+DLNode *dlist_insert(DList *list, DLNode *prev, void *data);
+
+/**
+ * @brief remove node from the end of the list, in O(1)
+ *
+ * @param list doubly linked list
+ * @return the node's data
+ */
+void *dlist_pop_back(DList *list);
+
+/**
+ * @brief remove node from the beginning of the list
+ *
+ * @param list doubly linked list
+ * @return the node's data
+ */
+void *dlist_pop_front(DList *list);
+
+/**
+ * @brief remove @p node from the list
+ *
+ * @param list doubly linked list
+ * @return the node's data
+ */
+void *dlist_remove(DList *list, DLNode *node);
+
+/**
+ * @brief move @p node to the beginning of the list, e.g. on a hit in an LRU list
+ *
+ * @param list doubly linked list
+ * @param node node of the list
+ */
+void dlist_move_front(DList *list, DLNode *node);
+
+/**
+ * @brief move @p node to the end of the list
+ *
+ * @param list doubly linked list
+ * @param node node of the list
+ */
+void dlist_move_back(DList *list, DLNode *node);
+
+/**
+ * @brief if the list contains data
+ *
+ * @param list doubly linked list
+ * @return boolean
+ */
+inline bool dlist_is_empty(DList *list) {
+    return list->head == (void *)0;
+}
+
+#endif /* __DLIST_H__ */
\ No newline at end of file
@@ -1,46 +1,87 @@
 #include "fixed_buffer.h"
+#include "allocator.h"
 
 #include <stdlib.h>
+#include <string.h>
+
+#define ALIGN_UP(n, align) (((n) + (align) - 1) & ~((size_t)(align) - 1))
 
 void fixedbuffer_init(FixedBuffer *fixed_buffer, void *buffer, size_t size) {
     size_t aligned_head;
 
-    // aligning the addres to a multiple of sizeof(void *)
-    aligned_head = (size_t)buffer;
-    aligned_head = (aligned_head + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    // aligning the addres to a multiple of ALLOCATOR_ALIGNMENT
+    aligned_head = ALIGN_UP((size_t)buffer, ALLOCATOR_ALIGNMENT);
 
     fixed_buffer->start = (char *)(aligned_head);
     fixed_buffer->head = (char *)(aligned_head);
-    fixed_buffer->end = fixed_buffer->start + size;
+    fixed_buffer->last = NULL;
+    fixed_buffer->end = ((char *)buffer) + size;
+    if (fixed_buffer->end < fixed_buffer->start)
+        fixed_buffer->end = fixed_buffer->start;
 }
 
 void *fixedbuffer_alloc(FixedBuffer *fixed_buffer, size_t size) {
-    void *next_head;
-
-    next_head = fixed_buffer->head + size;
+    return fixedbuffer_alloc_aligned(fixed_buffer, size, ALLOCATOR_ALIGNMENT);
+}
 
-    if (next_head > fixed_buffer->end)
-        return NULL;
+void *
+fixedbuffer_alloc_aligned(FixedBuffer *fixed_buffer, size_t size, size_t align) {
+    char *allocation;
 
-    void *allocation;
-    size_t aligned_head;
+    allocation = (char *)ALIGN_UP((size_t)fixed_buffer->head, align);
 
-    allocation = fixed_buffer->head;
-    fixed_buffer->head = next_head;
+    if (allocation > fixed_buffer->end
+        || size > (size_t)(fixed_buffer->end - allocation))
+        return NULL;
 
-    // aligning the addres to a multiple of sizeof(void *)
-    aligned_head = (size_t)fixed_buffer->head;
-    aligned_head = (aligned_head + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
-    fixed_buffer->head = (char *)(aligned_head);
+    fixed_buffer->head = allocation + size;
+    fixed_buffer->last = allocation;
 
     return allocation;
 }
 
 void *
 fixedbuffer_realloc(FixedBuffer *fixed_buffer, void *ptr, size_t new_size) {
-    return fixedbuffer_alloc(fixed_buffer, new_size);
+    return fixedbuffer_realloc_aligned(
+        fixed_buffer,
+        ptr,
+        new_size,
+        ALLOCATOR_ALIGNMENT
+    );
+}
+
+void *fixedbuffer_realloc_aligned(
+    FixedBuffer *fixed_buffer,
+    void *ptr,
+    size_t new_size,
+    size_t align
+) {
+    char *prev, *next;
+    size_t used;
+
+    prev = (char *)ptr;
+    if (!prev)
+        return fixedbuffer_alloc_aligned(fixed_buffer, new_size, align);
+
+    // the top allocation can grow up to the end of the buffer, anything else has to move
+    if (prev == fixed_buffer->last) {
+        if (new_size > (size_t)(fixed_buffer->end - prev))
+            return NULL;
+        fixed_buffer->head = prev + new_size;
+        return prev;
+    }
+
+    // the size of the allocation isn't stored, but nothing past head can belong to it
+    used = (size_t)(fixed_buffer->head - prev);
+
+    next = fixedbuffer_alloc_aligned(fixed_buffer, new_size, align);
+    if (next)
+        memcpy(next, prev, used < new_size ? used : new_size);
+
+    return next;
 }
 
 void fixedbuffer_clear(FixedBuffer *fixed_buffer) {
     fixed_buffer->head = fixed_buffer->start;
+    fixed_buffer->last = NULL;
 }
\ No newline at end of file
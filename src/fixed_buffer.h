@@ -1,10 +1,88 @@
+/**
+ * @file fixed_buffer.h
+ */
+
 #ifndef __FIXED_BUFFER_H__
 #define __FIXED_BUFFER_H__
 
+#include <stdlib.h>
+
+/**
+ * @brief allocator over a caller-provided buffer
+ */
 typedef struct FixedBuffer {
-    char *start;
-    char *end;
-    char *head;
+    char *start; /**< beginning of the buffer */
+    char *end;   /**< end of the buffer */
+    char *head;  /**< beginning of the free space */
+    char *last;  /**< the last allocation, which can be resized in place */
 } FixedBuffer;
 
+/**
+ * @brief initialize the FixedBuffer over @p buffer
+ *
+ * @param fixed_buffer FixedBuffer
+ * @param buffer memory to allocate from
+ * @param size size of @p buffer
+ */
+void fixedbuffer_init(FixedBuffer *fixed_buffer, void *buffer, size_t size);
+
+/**
+ * @brief allocate @p size bytes from the FixedBuffer, aligned to ALLOCATOR_ALIGNMENT
+ *
+ * @param fixed_buffer FixedBuffer
+ * @param size number of bytes
+ * @return pointer to the allocation, or NULL if there isn't enough space
+ */
+void *fixedbuffer_alloc(FixedBuffer *fixed_buffer, size_t size);
+
+/**
+ * @brief allocate @p size bytes from the FixedBuffer, aligned to @p align
+ *
+ * @param fixed_buffer FixedBuffer
+ * @param size number of bytes
+ * @param align alignment, must be a power of 2
+ * @return pointer to the allocation, or NULL if there isn't enough space
+ */
+void *
+fixedbuffer_alloc_aligned(FixedBuffer *fixed_buffer, size_t size, size_t align);
+
+/**
+ * @brief resize an allocation of the FixedBuffer
+ *
+ * if @p ptr is the last allocation, it's grown or shrunk in place.
+ * otherwise a new allocation is made and the content copied
+ *
+ * @param fixed_buffer FixedBuffer
+ * @param ptr allocation to resize, can be NULL
+ * @param new_size number of bytes requested
+ * @return pointer to the allocation, or NULL if there isn't enough space
+ */
+void *
+fixedbuffer_realloc(FixedBuffer *fixed_buffer, void *ptr, size_t new_size);
+
+/**
+ * @brief resize an allocation of the FixedBuffer, keeping it aligned to @p align
+ *
+ * see fixedbuffer_realloc()
+ *
+ * @param fixed_buffer FixedBuffer
+ * @param ptr allocation to resize, can be NULL
+ * @param new_size number of bytes requested
+ * @param align alignment, must be a power of 2
+ * @return pointer to the allocation, or NULL if there isn't enough space
+ */
+void *fixedbuffer_realloc_aligned(
+    FixedBuffer *fixed_buffer,
+    void *ptr,
+    size_t new_size,
+    size_t align
+);
+
+/**
+ * @brief release all the allocations of the FixedBuffer
+ *
+ * @param fixed_buffer FixedBuffer
+ */
+void fixedbuffer_clear(FixedBuffer *fixed_buffer);
+
 #endif /* __FIXED_BUFFER_H__ */
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "growth.h"
+
+#include <stdlib.h>
+
+#define ALIGN_UP(n, align) (((n) + (align) - 1) & ~((size_t)(align) - 1))
+
+size_t growth_next(Growth growth, size_t cap, size_t nbytes) {
+    size_t next;
+
+    if (growth == GROWTH_1_5X)
+        next = cap + cap / 2;
+    else
+        next = cap * 2;
+
+    if (next < nbytes)
+        next = nbytes;
+
+    // below a page there is nothing to gain from rounding, keep doubling
+    if (growth == GROWTH_PAGE) {
+        if (next >= GROWTH_HUGEPAGE_SIZE)
+            next = ALIGN_UP(next, GROWTH_HUGEPAGE_SIZE);
+        else if (next >= GROWTH_PAGE_SIZE)
+            next = ALIGN_UP(next, GROWTH_PAGE_SIZE);
+    }
+
+    return next;
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+/**
+ * @file growth.h
+ */
+
+#ifndef __GROWTH_H__
+#define __GROWTH_H__
+
+#include <stdlib.h>
+
+/**
+ * @brief page size assumed by GROWTH_PAGE
+ */
+#define GROWTH_PAGE_SIZE (4096UL)
+
+/**
+ * @brief huge page size assumed by GROWTH_PAGE
+ */
+#define GROWTH_HUGEPAGE_SIZE (2UL << 20)
+
+/**
+ * @brief how a container grows when it runs out of capacity
+ *
+ * if the request is bigger than what the policy gives, the exact request is used
+ */
+typedef enum Growth {
+    GROWTH_2X,   /**< double the capacity, the default */
+    GROWTH_1_5X, /**< grow by half the capacity, wastes less memory on long-lived containers */
+    GROWTH_PAGE, /**< double the capacity, rounded to GROWTH_PAGE_SIZE multiples (GROWTH_HUGEPAGE_SIZE past it), so big reallocs can remap pages instead of copying */
+} Growth;
+
+/**
+ * @brief the capacity to grow to
+ *
+ * @param growth policy
+ * @param cap current capacity, in bytes
+ * @param nbytes capacity required, in bytes
+ * @return new capacity in bytes, at least @p nbytes
+ */
+size_t growth_next(Growth growth, size_t cap, size_t nbytes);
+
+#endif /* __GROWTH_H__ */
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "hash.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline uint64_t hash_bytes(const void *p, size_t len);
+
+static const uint64_t secret[4] = {
+    0x2d358dccaa6c78a5ULL,
+    0x8bb84b93962eacc9ULL,
+    0x4b33a62ed433d4a3ULL,
+    0x4d5a2da51de1aa47ULL
+};
+
+// 64x64 -> 128 bit multiplication, low half in *a and high half in *b
+static inline void mum(uint64_t *a, uint64_t *b) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t r;
+
+    r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha, hb, la, lb, hi, lo, rh, rm0, rm1, rl, t, c;
+
+    ha = *a >> 32;
+    hb = *b >> 32;
+    la = (uint32_t)*a;
+    lb = (uint32_t)*b;
+    rh = ha * hb;
+    rm0 = ha * lb;
+    rm1 = hb * la;
+    rl = la * lb;
+    t = rl + (rm0 << 32);
+    c = t < rl;
+    lo = t + (rm1 << 32);
+    c += lo < t;
+    hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+static inline uint64_t mix(uint64_t a, uint64_t b) {
+    mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t read8(const uint8_t *p) {
+    uint64_t v;
+
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t read4(const uint8_t *p) {
+    uint32_t v;
+
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// 1 to 3 bytes
+static inline uint64_t read3(const uint8_t *p, size_t len) {
+    return (((uint64_t)p[0]) << 16) | (((uint64_t)p[len >> 1]) << 8) | p[len - 1];
+}
+
+uint64_t hash_bytes_seed(const void *key, size_t len, uint64_t seed) {
+    const uint8_t *p;
+    uint64_t a, b, see1, see2;
+    size_t i;
+
+    p = key;
+    seed ^= mix(seed ^ secret[0], secret[1]);
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+            b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = read3(p, len);
+            b = 0;
+        } else
+            a = b = 0;
+    } else {
+        i = len;
+        if (i > 48) {
+            see1 = seed;
+            see2 = seed;
+            do {
+                seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+                see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    mum(&a, &b);
+    return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
\ No newline at end of file
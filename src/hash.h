@@ -0,0 +1,34 @@
+/**
+ * @file hash.h
+ */
+
+#ifndef __HASH_H__
+#define __HASH_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @brief fast non-cryptographic 64 bit hash of @p len bytes
+ *
+ * wyhash (final version 4), by Wang Yi
+ *
+ * @param p bytes to hash
+ * @param len number of bytes
+ * @param seed seed, different seeds give unrelated hashes
+ * @return hash
+ */
+uint64_t hash_bytes_seed(const void *p, size_t len, uint64_t seed);
+
+/**
+ * @brief hash_bytes_seed() with seed 0
+ *
+ * @param p bytes to hash
+ * @param len number of bytes
+ * @return hash
+ */
+inline uint64_t hash_bytes(const void *p, size_t len) {
+    return hash_bytes_seed(p, len, 0);
+}
+
+#endif /* __HASH_H__ */
\ No newline at end of file
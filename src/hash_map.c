@@ -0,0 +1,473 @@
+#include "hash_map.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash.h"
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline size_t hashmap_len(HashMap *m);
+
+// control bytes compared at once
+#define GROUP (16)
+
+#define CTRL_EMPTY ((int8_t)-128)
+#define CTRL_DELETED ((int8_t)-2)
+
+// capacity of the first allocation
+#define MIN_CAP (16UL)
+
+#define NOT_FOUND ((size_t)-1)
+
+#define ALIGN_UP(n, align) (((n) + (align) - 1) & ~((size_t)(align) - 1))
+
+// bit i is set if control byte i of the group matches
+typedef uint32_t Mask;
+
+// compares the slot's key with the one searched
+typedef bool (*Func_Probe)(HashMap *m, const void *slot_key, const void *probe);
+
+/********************************************************************************************
+ *                                         GROUPS                                           *
+ ********************************************************************************************/
+
+static inline Mask group_match(const int8_t *group, int8_t h) {
+#if defined(__SSE2__)
+    __m128i ctrl;
+
+    ctrl = _mm_loadu_si128((const __m128i *)group);
+    return (Mask)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h)));
+#else
+    Mask mask;
+    int i;
+
+    for (i = 0, mask = 0; i < GROUP; i++)
+        mask |= (Mask)(group[i] == h) << i;
+    return mask;
+#endif
+}
+
+static inline Mask group_empty(const int8_t *group) {
+    return group_match(group, CTRL_EMPTY);
+}
+
+// empty or deleted, the only control bytes with the high bit set
+static inline Mask group_free(const int8_t *group) {
+#if defined(__SSE2__)
+    return (Mask)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+    Mask mask;
+    int i;
+
+    for (i = 0, mask = 0; i < GROUP; i++)
+        mask |= (Mask)(group[i] < 0) << i;
+    return mask;
+#endif
+}
+
+static inline unsigned lowest_bit(Mask mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned i;
+
+    for (i = 0; !(mask & 1); i++)
+        mask >>= 1;
+    return i;
+#endif
+}
+
+/********************************************************************************************
+ *                                          SLOTS                                           *
+ ********************************************************************************************/
+
+static inline size_t hash_pos(uint64_t hash) {
+    return (size_t)(hash >> 7);
+}
+
+static inline int8_t hash_ctrl(uint64_t hash) {
+    return (int8_t)(hash & 0x7F);
+}
+
+static inline char *slot_key(HashMap *m, size_t i) {
+    return m->keys + (i * m->key_szof);
+}
+
+static inline char *slot_val(HashMap *m, size_t i) {
+    return m->vals + (i * m->val_szof);
+}
+
+// the first GROUP control bytes are mirrored after the last, so groups can be loaded anywhere
+static inline void set_ctrl(HashMap *m, size_t i, int8_t h) {
+    m->ctrl[i] = h;
+    if (i < GROUP)
+        m->ctrl[m->cap + i] = h;
+}
+
+// keys stay under 7/8 of the slots
+static inline size_t max_load(size_t cap) {
+    return cap - cap / 8;
+}
+
+static inline size_t ctrl_size(size_t cap) {
+    return ALIGN_UP(cap + GROUP, ALLOCATOR_ALIGNMENT);
+}
+
+static inline size_t keys_size(HashMap *m, size_t cap) {
+    return ALIGN_UP(cap * m->key_szof, ALLOCATOR_ALIGNMENT);
+}
+
+// control bytes, keys and values share one allocation
+static inline size_t table_size(HashMap *m, size_t cap) {
+    return ctrl_size(cap) + keys_size(m, cap) + cap * m->val_szof;
+}
+
+static uint64_t key_hash(HashMap *m, const void *key) {
+    SStr *s;
+
+    if (m->sstr_keys) {
+        s = (SStr *)key;
+        return hash_bytes(sstr_data(s), sstr_len(s));
+    }
+    if (m->hash)
+        return m->hash(key);
+    return hash_bytes(key, m->key_szof);
+}
+
+static bool probe_view(HashMap *m, const void *slot, const void *probe) {
+    const SStrView *view;
+    SStr *s;
+
+    (void)m;
+    s = (SStr *)slot;
+    view = probe;
+    return sstr_len(s) == view->len && !memcmp(sstr_data(s), view->ptr, view->len);
+}
+
+static bool probe_key(HashMap *m, const void *slot, const void *probe) {
+    if (m->eq)
+        return m->eq(slot, probe);
+    return !memcmp(slot, probe, m->key_szof);
+}
+
+static size_t find(HashMap *m, uint64_t hash, const void *probe, Func_Probe eq) {
+    size_t pos, step, i;
+    int8_t *group;
+    Mask match;
+
+    if (!m->cap)
+        return NOT_FOUND;
+
+    // triangular probing over groups visits every slot of a power of two table
+    pos = hash_pos(hash) & (m->cap - 1);
+    for (step = GROUP;; step += GROUP) {
+        group = m->ctrl + pos;
+        for (match = group_match(group, hash_ctrl(hash)); match; match &= match - 1) {
+            i = (pos + lowest_bit(match)) & (m->cap - 1);
+            if (eq(m, slot_key(m, i), probe))
+                return i;
+        }
+        if (group_empty(group))
+            return NOT_FOUND;
+        pos = (pos + step) & (m->cap - 1);
+    }
+}
+
+// first empty or deleted slot of the probe sequence of @p hash
+static size_t find_free(HashMap *m, uint64_t hash) {
+    size_t pos, step;
+    Mask match;
+
+    pos = hash_pos(hash) & (m->cap - 1);
+    for (step = GROUP;; step += GROUP) {
+        if ((match = group_free(m->ctrl + pos)) != 0)
+            return (pos + lowest_bit(match)) & (m->cap - 1);
+        pos = (pos + step) & (m->cap - 1);
+    }
+}
+
+static void resize(HashMap *m, size_t cap) {
+    HashMap old;
+    size_t i, j;
+    uint64_t hash;
+
+    old = *m;
+    m->cap = cap;
+    m->ctrl = allocator_alloc(m->alloc, table_size(m, cap), 0);
+    m->keys = ((char *)m->ctrl) + ctrl_size(cap);
+    m->vals = m->keys + keys_size(m, cap);
+    memset(m->ctrl, CTRL_EMPTY, cap + GROUP);
+    m->growth_left = max_load(cap) - m->len;
+
+    for (i = 0; i < old.cap; i++) {
+        if (old.ctrl[i] >= 0) {
+            hash = key_hash(m, slot_key(&old, i));
+            j = find_free(m, hash);
+            set_ctrl(m, j, hash_ctrl(hash));
+            memcpy(slot_key(m, j), slot_key(&old, i), m->key_szof);
+            memcpy(slot_val(m, j), slot_val(&old, i), m->val_szof);
+        }
+    }
+
+    if (old.cap)
+        allocator_free(m->alloc, old.ctrl, table_size(&old, old.cap));
+}
+
+/**
+ * @brief slot of the key, found or inserted
+ *
+ * @param inserted if the slot is new, its key and value to be written by the caller
+ * @return the slot
+ */
+static size_t
+find_or_insert(HashMap *m, const void *probe, Func_Probe eq, uint64_t hash, bool *inserted) {
+    size_t i;
+
+    if ((i = find(m, hash, probe, eq)) != NOT_FOUND) {
+        *inserted = false;
+        return i;
+    }
+
+    if (!m->growth_left) {
+        // mostly deleted slots: rehash in place, otherwise double
+        if (!m->cap)
+            resize(m, MIN_CAP);
+        else if (m->len < max_load(m->cap) / 2)
+            resize(m, m->cap);
+        else
+            resize(m, m->cap * 2);
+    }
+
+    i = find_free(m, hash);
+    if (m->ctrl[i] == CTRL_EMPTY)
+        m->growth_left--;
+    set_ctrl(m, i, hash_ctrl(hash));
+    m->len++;
+    *inserted = true;
+
+    return i;
+}
+
+static void erase(HashMap *m, size_t i, void *val) {
+    if (val)
+        memcpy(val, slot_val(m, i), m->val_szof);
+    if (m->sstr_keys)
+        sstr_free((SStr *)slot_key(m, i));
+    set_ctrl(m, i, CTRL_DELETED);
+    m->len--;
+}
+
+// slot of the key, a new one gets a copy of the key and a zeroed value
+static size_t entry(HashMap *m, const void *key, bool *inserted) {
+    size_t i;
+
+    i = find_or_insert(m, key, probe_key, key_hash(m, key), inserted);
+    if (*inserted) {
+        memcpy(slot_key(m, i), key, m->key_szof);
+        memset(slot_val(m, i), 0, m->val_szof);
+    }
+    return i;
+}
+
+static size_t entry_str(HashMap *m, SStrView key, bool *inserted) {
+    SStr *s;
+    size_t i;
+
+    i = find_or_insert(m, &key, probe_view, hash_bytes(key.ptr, key.len), inserted);
+    if (*inserted) {
+        s = (SStr *)slot_key(m, i);
+        sstr_new_in(s, m->alloc);
+        sstr_cat_n(s, key.ptr, key.len);
+        memset(slot_val(m, i), 0, m->val_szof);
+    }
+    return i;
+}
+
+/********************************************************************************************
+ *                                           API                                            *
+ ********************************************************************************************/
+
+void hashmap_new(HashMap *m, size_t key_szof, size_t val_szof) {
+    hashmap_new_in(m, key_szof, val_szof, NULL);
+}
+
+void hashmap_new_in(HashMap *m, size_t key_szof, size_t val_szof, Allocator *alloc) {
+    hashmap_new_custom(m, key_szof, val_szof, NULL, NULL, alloc);
+}
+
+void hashmap_new_custom(
+    HashMap *m,
+    size_t key_szof,
+    size_t val_szof,
+    Func_Hash hash,
+    Func_Eq eq,
+    Allocator *alloc
+) {
+    m->ctrl = NULL;
+    m->keys = NULL;
+    m->vals = NULL;
+    m->cap = 0;
+    m->len = 0;
+    m->growth_left = 0;
+    m->key_szof = key_szof;
+    m->val_szof = val_szof;
+    m->hash = hash;
+    m->eq = eq;
+    m->sstr_keys = false;
+    m->alloc = alloc ? alloc : &allocator_std;
+}
+
+void hashmap_new_sstr(HashMap *m, size_t val_szof, Allocator *alloc) {
+    hashmap_new_in(m, sizeof(SStr), val_szof, alloc);
+    m->sstr_keys = true;
+}
+
+void hashmap_free(HashMap *m) {
+    if (m->cap) {
+        hashmap_clear(m);
+        allocator_free(m->alloc, m->ctrl, table_size(m, m->cap));
+    }
+    m->ctrl = NULL;
+    m->keys = NULL;
+    m->vals = NULL;
+    m->cap = 0;
+    m->len = 0;
+    m->growth_left = 0;
+}
+
+void hashmap_clear(HashMap *m) {
+    size_t i;
+
+    if (!m->cap)
+        return;
+    if (m->sstr_keys)
+        for (i = 0; i < m->cap; i++)
+            if (m->ctrl[i] >= 0)
+                sstr_free((SStr *)slot_key(m, i));
+    memset(m->ctrl, CTRL_EMPTY, m->cap + GROUP);
+    m->len = 0;
+    m->growth_left = max_load(m->cap);
+}
+
+void hashmap_reserve(HashMap *m, size_t nelem) {
+    size_t cap;
+
+    for (cap = MIN_CAP; max_load(cap) < nelem; cap *= 2)
+        ;
+    if (cap > m->cap)
+        resize(m, cap);
+}
+
+void *hashmap_get(HashMap *m, const void *key) {
+    size_t i;
+
+    if (m->sstr_keys)
+        return hashmap_get_str(m, sstrview_from_sstr((SStr *)key));
+
+    i = find(m, key_hash(m, key), key, probe_key);
+    return i == NOT_FOUND ? NULL : slot_val(m, i);
+}
+
+void *hashmap_put(HashMap *m, const void *key, const void *val) {
+    bool inserted;
+    size_t i;
+
+    if (m->sstr_keys)
+        return hashmap_put_str(m, sstrview_from_sstr((SStr *)key), val);
+
+    i = entry(m, key, &inserted);
+    if (val)
+        memcpy(slot_val(m, i), val, m->val_szof);
+    else if (!inserted)
+        memset(slot_val(m, i), 0, m->val_szof);
+
+    return slot_val(m, i);
+}
+
+void *hashmap_entry(HashMap *m, const void *key, bool *inserted, void **stored_key) {
+    bool is_new;
+    size_t i;
+
+    if (m->sstr_keys)
+        i = entry_str(m, sstrview_from_sstr((SStr *)key), &is_new);
+    else
+        i = entry(m, key, &is_new);
+    if (inserted)
+        *inserted = is_new;
+    if (stored_key)
+        *stored_key = slot_key(m, i);
+    return slot_val(m, i);
+}
+
+bool hashmap_remove(HashMap *m, const void *key, void *val) {
+    size_t i;
+
+    if (m->sstr_keys)
+        return hashmap_remove_str(m, sstrview_from_sstr((SStr *)key), val);
+
+    if ((i = find(m, key_hash(m, key), key, probe_key)) == NOT_FOUND)
+        return false;
+    erase(m, i, val);
+    return true;
+}
+
+void *hashmap_get_str(HashMap *m, SStrView key) {
+    size_t i;
+
+    i = find(m, hash_bytes(key.ptr, key.len), &key, probe_view);
+    return i == NOT_FOUND ? NULL : slot_val(m, i);
+}
+
+void *hashmap_put_str(HashMap *m, SStrView key, const void *val) {
+    bool inserted;
+    size_t i;
+
+    i = entry_str(m, key, &inserted);
+    if (val)
+        memcpy(slot_val(m, i), val, m->val_szof);
+    else if (!inserted)
+        memset(slot_val(m, i), 0, m->val_szof);
+
+    return slot_val(m, i);
+}
+
+void *hashmap_entry_str(HashMap *m, SStrView key, bool *inserted) {
+    bool is_new;
+    size_t i;
+
+    i = entry_str(m, key, &is_new);
+    if (inserted)
+        *inserted = is_new;
+    return slot_val(m, i);
+}
+
+bool hashmap_remove_str(HashMap *m, SStrView key, void *val) {
+    size_t i;
+
+    if ((i = find(m, hash_bytes(key.ptr, key.len), &key, probe_view)) == NOT_FOUND)
+        return false;
+    erase(m, i, val);
+    return true;
+}
+
+bool hashmap_next(HashMap *m, size_t *it, void **key, void **val) {
+    size_t i;
+
+    for (i = *it; i < m->cap; i++) {
+        if (m->ctrl[i] >= 0) {
+            if (key)
+                *key = slot_key(m, i);
+            if (val)
+                *val = slot_val(m, i);
+            *it = i + 1;
+            return true;
+        }
+    }
+    *it = i;
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+/**
+ * @file hash_map.h
+ */
+
+#ifndef __HASH_MAP_H__
+#define __HASH_MAP_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+#include "sstr.h"
+
+/**
+ * @brief callback to hash keys
+ */
+typedef uint64_t (*Func_Hash)(const void *key);
+
+/**
+ * @brief callback to compare keys for equality
+ */
+typedef bool (*Func_Eq)(const void *key1, const void *key2);
+
+/**
+ * @brief hash map with open addressing, SwissTable style
+ *
+ * keys and values of fixed size are stored by value in flat arrays.
+ * a control byte per slot keeps 7 bits of the hash, and probing compares
+ * 16 control bytes at a time (with SSE2 when available), so most lookups touch one key.
+ * with SStr keys (hashmap_new_sstr()) lookups take a SStrView, without copying
+ */
+typedef struct HashMap {
+    int8_t *ctrl;       /**< control bytes: empty, deleted, or 7 bits of the hash of the slot's key */
+    char *keys;         /**< the keys, cap of them */
+    char *vals;         /**< the values, cap of them */
+    size_t cap;         /**< number of slots, a power of two */
+    size_t len;         /**< number of keys */
+    size_t growth_left; /**< insertions in empty slots left before growing */
+    size_t key_szof;    /**< size of the keys */
+    size_t val_szof;    /**< size of the values */
+    Func_Hash hash;     /**< hash of the keys, NULL for their bytes' */
+    Func_Eq eq;         /**< equality of the keys, NULL for memcmp() */
+    bool sstr_keys;     /**< if the keys are SStr, owned by the map */
+    Allocator *alloc;   /**< where the memory comes from */
+} HashMap;
+
+/**
+ * @brief new HashMap, comparing and hashing the keys by their bytes
+ *
+ * @param m HashMap
+ * @param key_szof size of the keys
+ * @param val_szof size of the values
+ */
+void hashmap_new(HashMap *m, size_t key_szof, size_t val_szof);
+
+/**
+ * @brief new HashMap, using @p alloc for its memory
+ *
+ * @param m HashMap
+ * @param key_szof size of the keys
+ * @param val_szof size of the values
+ * @param alloc Allocator, NULL for allocator_std
+ */
+void hashmap_new_in(HashMap *m, size_t key_szof, size_t val_szof, Allocator *alloc);
+
+/**
+ * @brief new HashMap, with custom hashing and equality of the keys
+ *
+ * e.g. for keys that are pointers to the data to compare
+ *
+ * @param m HashMap
+ * @param key_szof size of the keys
+ * @param val_szof size of the values
+ * @param hash hash of the keys, NULL for their bytes'
+ * @param eq equality of the keys, NULL for memcmp()
+ * @param alloc Allocator, NULL for allocator_std
+ */
+void hashmap_new_custom(
+    HashMap *m,
+    size_t key_szof,
+    size_t val_szof,
+    Func_Hash hash,
+    Func_Eq eq,
+    Allocator *alloc
+);
+
+/**
+ * @brief new HashMap with string keys, owned by the map
+ *
+ * the keys are SStr, compared by content: use the _str functions with a SStrView,
+ * or the generic ones with a pointer to SStr, whose content is copied like the views
+ *
+ * @param m HashMap
+ * @param val_szof size of the values
+ * @param alloc Allocator, for the map and its keys, NULL for allocator_std
+ */
+void hashmap_new_sstr(HashMap *m, size_t val_szof, Allocator *alloc);
+
+/**
+ * @brief release memory, and the SStr keys
+ *
+ * if the values own memory, that needs to be release before by the caller
+ *
+ * @param m HashMap
+ */
+void hashmap_free(HashMap *m);
+
+/**
+ * @brief remove all the keys but don't free the memory, so it can be reused
+ *
+ * @param m HashMap
+ */
+void hashmap_clear(HashMap *m);
+
+/**
+ * @brief reserve memory ahead of time
+ *
+ * @param m HashMap
+ * @param nelem number of keys to reserve memory for
+ */
+void hashmap_reserve(HashMap *m, size_t nelem);
+
+/**
+ * @brief number of keys
+ *
+ * @param m HashMap
+ * @return length
+ */
+inline size_t hashmap_len(HashMap *m) {
+    return m->len;
+}
+
+/**
+ * @brief value of @p key
+ *
+ * if changes to the HashMap are made, this pointer can become invalid
+ *
+ * @param m HashMap
+ * @param key key searched
+ * @return pointer to the value, NULL if not found
+ */
+void *hashmap_get(HashMap *m, const void *key);
+
+/**
+ * @brief insert @p key with @p val through shallow-copy, or overwrite its value
+ *
+ * @param m HashMap
+ * @param key key
+ * @param val value, if NULL it's zeroed
+ * @return pointer to the value in the map
+ */
+void *hashmap_put(HashMap *m, const void *key, const void *val);
+
+/**
+ * @brief value of @p key, inserted if missing, hashing and probing only once
+ *
+ * a new entry gets a shallow copy of @p key and a zeroed value, to be filled through the pointer returned.
+ * the key stored can be overwritten through @p stored_key with an equal one (same hash, equal by Func_Eq),
+ * e.g. one pointing to memory owned by the caller
+ *
+ * @param m HashMap
+ * @param key key
+ * @param inserted set to true if the key wasn't in the map, can be NULL
+ * @param stored_key where to put the pointer to the key in the map, can be NULL
+ * @return pointer to the value in the map
+ */
+void *hashmap_entry(HashMap *m, const void *key, bool *inserted, void **stored_key);
+
+/**
+ * @brief remove @p key
+ *
+ * with SStr keys, the key is freed
+ *
+ * @param m HashMap
+ * @param key key to remove
+ * @param val where to copy the value removed, can be NULL
+ * @return false if not found
+ */
+bool hashmap_remove(HashMap *m, const void *key, void *val);
+
+/**
+ * @brief value of @p key, in a map with SStr keys
+ *
+ * @param m HashMap
+ * @param key key searched
+ * @return pointer to the value, NULL if not found
+ */
+void *hashmap_get_str(HashMap *m, SStrView key);
+
+/**
+ * @brief insert a copy of @p key with @p val, or overwrite its value, in a map with SStr keys
+ *
+ * the key is copied only if it's not in the map already
+ *
+ * @param m HashMap
+ * @param key key
+ * @param val value, if NULL it's zeroed
+ * @return pointer to the value in the map
+ */
+void *hashmap_put_str(HashMap *m, SStrView key, const void *val);
+
+/**
+ * @brief value of @p key, inserted with a zeroed value if missing, in a map with SStr keys
+ *
+ * see hashmap_entry(), the key is copied only if it's not in the map already
+ *
+ * @param m HashMap
+ * @param key key
+ * @param inserted set to true if the key wasn't in the map, can be NULL
+ * @return pointer to the value in the map
+ */
+void *hashmap_entry_str(HashMap *m, SStrView key, bool *inserted);
+
+/**
+ * @brief remove @p key, in a map with SStr keys
+ *
+ * @param m HashMap
+ * @param key key to remove
+ * @param val where to copy the value removed, can be NULL
+ * @return false if not found
+ */
+bool hashmap_remove_str(HashMap *m, SStrView key, void *val);
+
+/**
+ * @brief iterate over the keys and values, in no particular order
+ *
+ * e.g. `size_t it = 0; while (hashmap_next(m, &it, &key, &val)) ...`
+ * the map must not be changed while iterating
+ *
+ * @param m HashMap
+ * @param it iterator, 0 to start
+ * @param key where to put the pointer to the key, can be NULL
+ * @param val where to put the pointer to the value, can be NULL
+ * @return false when there's nothing left
+ */
+bool hashmap_next(HashMap *m, size_t *it, void **key, void **val);
+
+#endif /* __HASH_MAP_H__ */
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "ilist.h"
+
+#include <stdlib.h>
+
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline bool ilist_is_empty(IList *list);
+
+void ilist_init(IList *list) {
+    list->head = NULL;
+    list->tail = NULL;
+}
+
+IListLink *ilist_next(IList *list, IListLink *curr) {
+    if (curr)
+        return curr->next;
+    else
+        return list->head;
+}
+
+IListLink *ilist_prev(IList *list, IListLink *curr) {
+    if (curr)
+        return curr->prev;
+    else
+        return list->tail;
+}
+
+void ilist_push_back(IList *list, IListLink *link) {
+    ilist_insert(list, list->tail, link);
+}
+
+void ilist_push_front(IList *list, IListLink *link) {
+    ilist_insert(list, NULL, link);
+}
+
+void ilist_insert(IList *list, IListLink *prev, IListLink *link) {
+    link->prev = prev;
+    link->next = prev ? prev->next : list->head;
+    if (link->next)
+        link->next->prev = link;
+    else
+        list->tail = link;
+    if (prev)
+        prev->next = link;
+    else
+        list->head = link;
+}
+
+IListLink *ilist_pop_back(IList *list) {
+    IListLink *link;
+
+    if ((link = list->tail) != NULL)
+        ilist_remove(list, link);
+    return link;
+}
+
+IListLink *ilist_pop_front(IList *list) {
+    IListLink *link;
+
+    if ((link = list->head) != NULL)
+        ilist_remove(list, link);
+    return link;
+}
+
+void ilist_remove(IList *list, IListLink *link) {
+    if (link->prev)
+        link->prev->next = link->next;
+    else
+        list->head = link->next;
+    if (link->next)
+        link->next->prev = link->prev;
+    else
+        list->tail = link->prev;
+    link->next = link->prev = NULL;
+}
+
+void ilist_move_front(IList *list, IListLink *link) {
+    if (list->head != link) {
+        ilist_remove(list, link);
+        ilist_insert(list, NULL, link);
+    }
+}
+
+void ilist_move_back(IList *list, IListLink *link) {
+    if (list->tail != link) {
+        ilist_remove(list, link);
+        ilist_insert(list, list->tail, link);
+    }
+}
\ No newline at end of file
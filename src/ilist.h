@@ -0,0 +1,151 @@
+/**
+ * @file ilist.h
+ */
+
+#ifndef __ILIST_H__
+#define __ILIST_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief link of an intrusive list, embedded in the user's struct
+ */
+typedef struct IListLink {
+    struct IListLink *next; /**< the next link */
+    struct IListLink *prev; /**< the previous link */
+} IListLink;
+
+/**
+ * @brief intrusive doubly linked list
+ *
+ * the elements are the user's structs, linked through an IListLink member,
+ * so the list never allocates and the data is next to the link.
+ * an element can be in as many lists at once as it has links
+ */
+typedef struct IList {
+    IListLink *head; /**< beginning of the list */
+    IListLink *tail; /**< end of the list */
+} IList;
+
+/**
+ * @brief the struct containing @p link
+ *
+ * e.g. `Timer *t = ILIST_ENTRY(link, Timer, link);`
+ *
+ * @param link pointer to the IListLink
+ * @param type type of the struct
+ * @param member name of the IListLink member in @p type
+ */
+#define ILIST_ENTRY(link, type, member) \
+    ((type *)(((char *)(link)) - offsetof(type, member)))
+
+/**
+ * @brief initialize the list
+ *
+ * there's nothing to free, the elements are owned by the user
+ *
+ * @param list intrusive list
+ */
+void ilist_init(IList *list);
+
+/**
+ * @brief return the link after @p curr
+ *
+ * if @p curr == NULL, returns the first link
+ *
+ * @param list intrusive list
+ * @param curr current link
+ * @return the next link
+ */
+IListLink *ilist_next(IList *list, IListLink *curr);
+
+/**
+ * @brief return the link before @p curr
+ *
+ * if @p curr == NULL, returns the last link
+ *
+ * @param list intrusive list
+ * @param curr current link
+ * @return the previous link
+ */
+IListLink *ilist_prev(IList *list, IListLink *curr);
+
+/**
+ * @brief insert @p link at the end of the list
+ *
+ * @param list intrusive list
+ * @param link link not in the list
+ */
+void ilist_push_back(IList *list, IListLink *link);
+
+/**
+ * @brief insert @p link at the beginning of the list
+ *
+ * @param list intrusive list
+ * @param link link not in the list
+ */
+void ilist_push_front(IList *list, IListLink *link);
+
+/**
+ * @brief insert @p link after @p prev
+ *
+ * if @p prev is NULL, insert at the beginning of the list
+ *
+ * @param list intrusive list
+ * @param prev link before the one to be inserted
+ * @param link link not in the list
+ */
+void ilist_insert(IList *list, IListLink *prev, IListLink *link);
+
+/**
+ * @brief remove the link from the end of the list
+ *
+ * @param list intrusive list
+ * @return the link removed, NULL if the list is empty
+ */
+IListLink *ilist_pop_back(IList *list);
+
+/**
+ * @brief remove the link from the beginning of the list
+ *
+ * @param list intrusive list
+ * @return the link removed, NULL if the list is empty
+ */
+IListLink *ilist_pop_front(IList *list);
+
+/**
+ * @brief remove @p link from the list, in O(1)
+ *
+ * @param list intrusive list
+ * @param link link of the list
+ */
+void ilist_remove(IList *list, IListLink *link);
+
+/**
+ * @brief move @p link to the beginning of the list
+ *
+ * @param list intrusive list
+ * @param link link of the list
+ */
+void ilist_move_front(IList *list, IListLink *link);
+
+/**
+ * @brief move @p link to the end of the list
+ *
+ * @param list intrusive list
+ * @param link link of the list
+ */
+void ilist_move_back(IList *list, IListLink *link);
+
+/**
+ * @brief if the list contains elements
+ *
+ * @param list intrusive list
+ * @return boolean
+ */
+inline bool ilist_is_empty(IList *list) {
+    return list->head == (void *)0;
+}
+
+#endif /* __ILIST_H__ */
\ No newline at end of file
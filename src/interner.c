@@ -0,0 +1,79 @@
+#include "interner.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash.h"
+
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline SStrView interner_view(Interner *in, InternId id);
+extern inline const char *interner_str(Interner *in, InternId id);
+extern inline size_t interner_len(Interner *in);
+
+// the map's keys are views, compared by content
+static uint64_t view_hash(const void *key) {
+    const SStrView *view;
+
+    view = key;
+    return hash_bytes(view->ptr, view->len);
+}
+
+static bool view_eq(const void *key1, const void *key2) {
+    return sstrview_eq(*(const SStrView *)key1, *(const SStrView *)key2);
+}
+
+void interner_init(Interner *in) {
+    arena_init(&in->arena);
+    hashmap_new_custom(
+        &in->map,
+        sizeof(SStrView),
+        sizeof(InternId),
+        view_hash,
+        view_eq,
+        NULL
+    );
+    vec_new(&in->strs, sizeof(SStrView));
+}
+
+void interner_free(Interner *in) {
+    hashmap_free(&in->map);
+    vec_free(&in->strs);
+    arena_free(&in->arena);
+}
+
+InternId interner_intern(Interner *in, SStrView s) {
+    InternId *id;
+    SStrView *key;
+    bool inserted;
+    char *bytes;
+
+    // one probe: a miss inserts the caller's view, then replaced by the copy
+    id = hashmap_entry(&in->map, &s, &inserted, (void **)&key);
+    if (!inserted)
+        return *id;
+
+    bytes = arena_alloc_unaligned(&in->arena, s.len + 1);
+    if (s.len)
+        memcpy(bytes, s.ptr, s.len);
+    bytes[s.len] = '\0';
+    *key = sstrview_from_n(bytes, s.len);
+
+    *id = (InternId)in->strs.len;
+    vec_push(&in->strs, key);
+
+    return *id;
+}
+
+const char *interner_intern_str(Interner *in, SStrView s) {
+    return interner_str(in, interner_intern(in, s));
+}
+
+bool interner_find(Interner *in, SStrView s, InternId *id) {
+    InternId *found;
+
+    if ((found = hashmap_get(&in->map, &s)) == NULL)
+        return false;
+    if (id)
+        *id = *found;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**
+ * @file interner.h
+ */
+
+#ifndef __INTERNER_H__
+#define __INTERNER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "arena.h"
+#include "hash_map.h"
+#include "sstr.h"
+#include "vec.h"
+
+/**
+ * @brief id of an interned string, in order of insertion from 0
+ */
+typedef uint32_t InternId;
+
+/**
+ * @brief string interning table
+ *
+ * every distinct string is stored once, NUL-terminated, packed in an Arena, so its pointer is stable
+ * until interner_free(). two interned strings are equal iff their ids (or pointers) are equal
+ */
+typedef struct Interner {
+    Arena arena; /**< the bytes of the strings */
+    HashMap map; /**< SStrView of the strings in the arena -> InternId */
+    Vec strs;    /**< SStrView of the strings, by InternId */
+} Interner;
+
+/**
+ * @brief initialize the Interner
+ *
+ * @param in Interner
+ */
+void interner_init(Interner *in);
+
+/**
+ * @brief release all the strings, invalidating their pointers
+ *
+ * @param in Interner
+ */
+void interner_free(Interner *in);
+
+/**
+ * @brief id of @p s, interning a copy of it if it's new
+ *
+ * @param in Interner
+ * @param s string
+ * @return id of the string
+ */
+InternId interner_intern(Interner *in, SStrView s);
+
+/**
+ * @brief stable pointer to the interned copy of @p s, interning it if it's new
+ *
+ * @param in Interner
+ * @param s string
+ * @return NUL-terminated string, equal pointers for equal strings
+ */
+const char *interner_intern_str(Interner *in, SStrView s);
+
+/**
+ * @brief id of @p s, without interning it
+ *
+ * @param in Interner
+ * @param s string
+ * @param id where to put the id, can be NULL
+ * @return false if @p s was never interned
+ */
+bool interner_find(Interner *in, SStrView s, InternId *id);
+
+/**
+ * @brief the interned string @p id
+ *
+ * @param in Interner
+ * @param id id from interner_intern()
+ * @return view of the string, which is NUL-terminated
+ */
+inline SStrView interner_view(Interner *in, InternId id) {
+    return ((SStrView *)in->strs.ptr)[id];
+}
+
+/**
+ * @brief the interned string @p id, NUL-terminated
+ *
+ * @param in Interner
+ * @param id id from interner_intern()
+ * @return pointer to the string
+ */
+inline const char *interner_str(Interner *in, InternId id) {
+    return ((SStrView *)in->strs.ptr)[id].ptr;
+}
+
+/**
+ * @brief number of distinct strings
+ *
+ * @param in Interner
+ * @return length
+ */
+inline size_t interner_len(Interner *in) {
+    return in->strs.len;
+}
+
+#endif /* __INTERNER_H__ */
\ No newline at end of file
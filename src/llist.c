@@ -2,29 +2,57 @@
 
 #include <stdlib.h>
 
-static LLNode *llnode_new(void *data) {
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline bool llist_is_empty(LList *list);
+
+static inline NodePool *llist_pool(LList *list) {
+    return list->shared ? list->shared : &list->pool;
+}
+
+static LLNode *llnode_new(LList *list, void *data) {
     LLNode *node;
 
-    node = malloc(sizeof(LLNode));
+    node = nodepool_alloc(llist_pool(list));
     node->data = data;
     node->next = NULL;
 
     return node;
 }
 
-static inline void llnode_free(LLNode *node, Func_Free func_free) {
+static inline void
+llnode_free(LList *list, LLNode *node, Func_Free func_free) {
     if (func_free)
         func_free(node->data);
-    free(node);
+    nodepool_release(llist_pool(list), node);
 }
 
 void llist_init(LList *list) {
+    llist_init_in(list, NULL);
+}
+
+void llist_init_in(LList *list, Allocator *alloc) {
     list->head = NULL;
     list->tail = NULL;
+    list->alloc = alloc ? alloc : &allocator_std;
+    nodepool_init(&list->pool, sizeof(LLNode), list->alloc);
+    list->shared = NULL;
+}
+
+void llist_init_shared(LList *list, NodePool *pool) {
+    llist_init_in(list, pool->alloc);
+    list->shared = pool;
 }
 
 void llist_free(LList *list, Func_Free func_free) {
-    if (!llist_is_empty(list)) {
+    if (!list->shared) {
+        LLNode *curr;
+
+        if (func_free)
+            for (curr = list->head; curr; curr = curr->next)
+                func_free(curr->data);
+        nodepool_free(&list->pool);
+        list->head = list->tail = NULL;
+    } else if (!llist_is_empty(list)) {
         LLNode *curr, *next;
 
         curr = list->head;
@@ -33,10 +61,10 @@ void llist_free(LList *list, Func_Free func_free) {
         while (next) {
             curr = next;
             next = next->next;
-            llnode_free(curr, func_free);
+            llnode_free(list, curr, func_free);
         }
 
-        llnode_free(list->head, func_free);
+        llnode_free(list, list->head, func_free);
         list->head = list->tail = NULL;
     }
 }
@@ -62,7 +90,7 @@ LLNode *llist_prev(LList *list, LLNode *curr) {
 LLNode *llist_push_back(LList *list, void *data) {
     LLNode *node;
 
-    node = llnode_new(data);
+    node = llnode_new(list, data);
 
     if (!llist_is_empty(list)) {
         list->tail->next = node;
@@ -76,7 +104,7 @@ LLNode *llist_push_back(LList *list, void *data) {
 LLNode *llist_push_front(LList *list, void *data) {
     LLNode *node;
 
-    node = llnode_new(data);
+    node = llnode_new(list, data);
 
     if (!llist_is_empty(list)) {
         node->next = list->head;
@@ -91,7 +119,7 @@ LLNode *llist_insert(LList *list, LLNode *prev, void *data) {
     if (prev) {
         LLNode *node;
 
-        node = llnode_new(data);
+        node = llnode_new(list, data);
         node->next = prev->next;
         prev->next = node;
 
@@ -119,7 +147,7 @@ void *llist_pop_back(LList *list) {
             }
         }
 
-        llnode_free(to_remove, NULL);
+        llnode_free(list, to_remove, NULL);
 
         return data;
     }
@@ -140,7 +168,7 @@ void *llist_pop_front(LList *list) {
         else
             list->head = list->head->next;
 
-        llnode_free(to_remove, NULL);
+        llnode_free(list, to_remove, NULL);
 
         return data;
     }
@@ -155,12 +183,16 @@ void *llist_remove(LList *list, LLNode *node) {
 
         if (list->head == node) {
             list->head = node->next;
+            if (list->tail == node)
+                list->tail = NULL;
             data = node->data;
-            llnode_free(node, NULL);
+            llnode_free(list, node, NULL);
         } else if ((prev = llist_prev(list, node)) != NULL) {
             prev->next = node->next;
+            if (list->tail == node)
+                list->tail = prev;
             data = node->data;
-            llnode_free(node, NULL);
+            llnode_free(list, node, NULL);
         } else
             data = NULL;
 
@@ -7,6 +7,9 @@
 
 #include <stdbool.h>
 
+#include "allocator.h"
+#include "node_pool.h"
+
 /**
  * @brief linked list's node
  */
@@ -22,10 +25,15 @@ typedef void (*Func_Free)(void *);
 
 /**
  * @brief linked list
+ *
+ * the nodes come from a NodePool, the list's own or one shared with other lists
  */
 typedef struct LList {
     LLNode *head;     /**< beginning of the list */
     LLNode *tail;     /**< end of the list */
+    Allocator *alloc; /**< where the blocks of nodes come from */
+    NodePool pool;    /**< the list's own nodes */
+    NodePool *shared; /**< pool shared with other lists, NULL for the list's own */
 } LList;
 
 /**
@@ -35,11 +43,30 @@ typedef struct LList {
  */
 void llist_init(LList *list);
 
+/**
+ * @brief initialize the list, with nodes coming from @p alloc
+ *
+ * @param list linked list
+ * @param alloc Allocator, if NULL allocator_std
+ */
+void llist_init_in(LList *list, Allocator *alloc);
+
+/**
+ * @brief initialize the list, with nodes coming from @p pool
+ *
+ * the pool is shared with other lists, so llist_free() gives the nodes back one by one
+ *
+ * @param list linked list
+ * @param pool NodePool, with nodes of at least sizeof(LLNode)
+ */
+void llist_init_shared(LList *list, NodePool *pool);
+
 /**
  * @brief free the list
  * 
- * won't free the nodes's data, only the list, if @p func_free is NULL
- * 
+ * won't free the nodes's data, only the list, if @p func_free is NULL.
+ * with the list's own pool, the blocks of nodes are released all at once
+ *
  * @param list linked list
  * @param func_free callback to free the nodes's data
  */
@@ -0,0 +1,135 @@
+#include "mpmc_queue.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ALIGN_UP(n, align) (((n) + (align) - 1) & ~((size_t)(align) - 1))
+
+// the element follows the sequence number in the cell
+#define CELL_HEADER sizeof(atomic_size_t)
+
+static size_t round_pow2(size_t n) {
+    size_t pow2;
+
+    for (pow2 = 2; pow2 < n; pow2 <<= 1)
+        ;
+    return pow2;
+}
+
+static inline atomic_size_t *cell_seq(MpmcQueue *q, size_t pos) {
+    return (atomic_size_t *)(q->cells + ((pos & q->mask) * q->cell_szof));
+}
+
+static inline char *cell_data(MpmcQueue *q, size_t pos) {
+    return q->cells + ((pos & q->mask) * q->cell_szof) + CELL_HEADER;
+}
+
+int mpmcqueue_init(MpmcQueue *q, size_t szof, size_t cap, Allocator *alloc) {
+    size_t i;
+
+    cap = round_pow2(cap);
+
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->head, 0);
+    q->mask = cap - 1;
+    q->szof = szof;
+    q->cell_szof = ALIGN_UP(CELL_HEADER + szof, alignof(atomic_size_t));
+    q->alloc = alloc ? alloc : &allocator_std;
+    if ((q->cells = allocator_alloc(q->alloc, cap * q->cell_szof, 0)) == NULL)
+        return -1;
+
+    // cell i is free for the producer of position i
+    for (i = 0; i < cap; i++)
+        atomic_init(cell_seq(q, i), i);
+    return 0;
+}
+
+void mpmcqueue_free(MpmcQueue *q) {
+    allocator_free(q->alloc, q->cells, (q->mask + 1) * q->cell_szof);
+    q->cells = NULL;
+}
+
+/**
+ * @brief claim up to @p nelem cells in a row, starting from @p index
+ *
+ * a cell at position pos is ready when its sequence number is pos + @p lag:
+ * 0 for producers (free), 1 for consumers (full)
+ *
+ * @return first position claimed, the number of cells is in @p nelem (0 if none)
+ */
+static size_t claim(MpmcQueue *q, atomic_size_t *index, size_t *nelem, size_t lag) {
+    size_t pos, seq, n;
+    intptr_t dif = 0;
+
+    pos = atomic_load_explicit(index, memory_order_relaxed);
+    for (;;) {
+        for (n = 0; n < *nelem; n++) {
+            seq = atomic_load_explicit(cell_seq(q, pos + n), memory_order_acquire);
+            dif = (intptr_t)seq - (intptr_t)(pos + n + lag);
+            if (dif)
+                break;
+        }
+
+        if (n) {
+            if (atomic_compare_exchange_weak_explicit(
+                    index,
+                    &pos,
+                    pos + n,
+                    memory_order_relaxed,
+                    memory_order_relaxed
+                )) {
+                *nelem = n;
+                return pos;
+            }
+        } else if (dif < 0) {
+            // the cell is a lap behind: full for producers, empty for consumers
+            *nelem = 0;
+            return pos;
+        } else {
+            // another thread claimed it in the meantime
+            pos = atomic_load_explicit(index, memory_order_relaxed);
+        }
+    }
+}
+
+bool mpmcqueue_push(MpmcQueue *q, const void *elem) {
+    return mpmcqueue_push_n(q, elem, 1) == 1;
+}
+
+bool mpmcqueue_pop(MpmcQueue *q, void *elem) {
+    return mpmcqueue_pop_n(q, elem, 1) == 1;
+}
+
+size_t mpmcqueue_push_n(MpmcQueue *q, const void *elems, size_t nelem) {
+    size_t pos, i;
+
+    if (!nelem)
+        return 0;
+    pos = claim(q, &q->tail, &nelem, 0);
+    for (i = 0; i < nelem; i++) {
+        memcpy(cell_data(q, pos + i), ((const char *)elems) + (i * q->szof), q->szof);
+        // full for the consumer of this lap
+        atomic_store_explicit(cell_seq(q, pos + i), pos + i + 1, memory_order_release);
+    }
+    return nelem;
+}
+
+size_t mpmcqueue_pop_n(MpmcQueue *q, void *elems, size_t nelem) {
+    size_t pos, i;
+
+    if (!nelem)
+        return 0;
+    pos = claim(q, &q->head, &nelem, 1);
+    for (i = 0; i < nelem; i++) {
+        memcpy(((char *)elems) + (i * q->szof), cell_data(q, pos + i), q->szof);
+        // free for the producer of the next lap
+        atomic_store_explicit(
+            cell_seq(q, pos + i),
+            pos + i + q->mask + 1,
+            memory_order_release
+        );
+    }
+    return nelem;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @file mpmc_queue.h
+ */
+
+#ifndef __MPMC_QUEUE_H__
+#define __MPMC_QUEUE_H__
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+#include "spsc_queue.h"
+
+/**
+ * @brief bounded lock-free queue, for any number of producer and consumer threads
+ *
+ * Dmitry Vyukov's design: every cell carries a sequence number telling whether it's free
+ * or full for the current lap, so producers and consumers only compete on their own index.
+ * elements are of szof bytes, like Vec's.
+ * the struct is aligned to QUEUE_CACHE_LINE, heap allocated ones need aligned_alloc()
+ */
+typedef struct MpmcQueue {
+    alignas(QUEUE_CACHE_LINE) atomic_size_t tail; /**< next position to push, shared by the producers */
+    alignas(QUEUE_CACHE_LINE) atomic_size_t head; /**< next position to pop, shared by the consumers */
+    alignas(QUEUE_CACHE_LINE) char *cells;        /**< the cells: sequence number then element */
+    size_t mask;                                  /**< capacity - 1, the capacity is a power of two */
+    size_t szof;                                  /**< sizeof() of the data type to be held */
+    size_t cell_szof;                             /**< size of a cell */
+    Allocator *alloc;                             /**< where the memory comes from */
+} MpmcQueue;
+
+/**
+ * @brief initialize the queue
+ *
+ * @param q MpmcQueue
+ * @param szof size of the single elements it's going to contain
+ * @param cap minimum number of elements, rounded up to a power of two
+ * @param alloc Allocator, NULL for allocator_std
+ * @return 0 on success, -1 if the memory can't be allocated
+ */
+int mpmcqueue_init(MpmcQueue *q, size_t szof, size_t cap, Allocator *alloc);
+
+/**
+ * @brief release memory
+ *
+ * no thread may be using the queue
+ *
+ * @param q MpmcQueue
+ */
+void mpmcqueue_free(MpmcQueue *q);
+
+/**
+ * @brief append an element through shallow-copy
+ *
+ * @param q MpmcQueue
+ * @param elem element to insert
+ * @return false if the queue is full
+ */
+bool mpmcqueue_push(MpmcQueue *q, const void *elem);
+
+/**
+ * @brief remove the oldest element
+ *
+ * @param q MpmcQueue
+ * @param elem where to copy the element removed
+ * @return false if the queue is empty
+ */
+bool mpmcqueue_pop(MpmcQueue *q, void *elem);
+
+/**
+ * @brief append as many elements as there are free cells in a row
+ *
+ * the cells are claimed with a single atomic operation, so the elements stay contiguous
+ *
+ * @param q MpmcQueue
+ * @param elems array of elements
+ * @param nelem number of elements of the array
+ * @return number of elements inserted
+ */
+size_t mpmcqueue_push_n(MpmcQueue *q, const void *elems, size_t nelem);
+
+/**
+ * @brief remove up to @p nelem of the oldest elements
+ *
+ * the cells are claimed with a single atomic operation
+ *
+ * @param q MpmcQueue
+ * @param elems where to copy the elements removed
+ * @param nelem maximum number of elements to remove
+ * @return number of elements removed
+ */
+size_t mpmcqueue_pop_n(MpmcQueue *q, void *elems, size_t nelem);
+
+#endif /* __MPMC_QUEUE_H__ */
\ No newline at end of file
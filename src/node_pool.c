@@ -0,0 +1,69 @@
+#include "node_pool.h"
+
+#include <stdlib.h>
+
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline void *nodepool_alloc(NodePool *pool);
+extern inline void nodepool_release(NodePool *pool, void *node);
+
+#define ALIGN_UP(n, align) (((n) + (align) - 1) & ~((size_t)(align) - 1))
+
+// the nodes start after the header, aligned like the nodes themselves
+#define BLOCK_HEADER ALIGN_UP(sizeof(NodePoolBlock), ALLOCATOR_ALIGNMENT)
+
+static inline size_t block_size(NodePool *pool) {
+    return BLOCK_HEADER + pool->node_size * pool->block_nodes;
+}
+
+void nodepool_init(NodePool *pool, size_t node_size, Allocator *alloc) {
+    nodepool_init_with(pool, node_size, NODEPOOL_BLOCK_NODES, alloc);
+}
+
+void nodepool_init_with(
+    NodePool *pool,
+    size_t node_size,
+    size_t block_nodes,
+    Allocator *alloc
+) {
+    // a released node holds the free list's pointer
+    if (node_size < sizeof(void *))
+        node_size = sizeof(void *);
+
+    pool->free_list = NULL;
+    pool->head = NULL;
+    pool->end = NULL;
+    pool->blocks = NULL;
+    pool->node_size = ALIGN_UP(node_size, ALLOCATOR_ALIGNMENT);
+    pool->block_nodes = block_nodes ? block_nodes : NODEPOOL_BLOCK_NODES;
+    pool->alloc = alloc ? alloc : &allocator_std;
+}
+
+void nodepool_free(NodePool *pool) {
+    NodePoolBlock *block, *next;
+
+    for (block = pool->blocks; block; block = next) {
+        next = block->next;
+        allocator_free(pool->alloc, block, block_size(pool));
+    }
+    pool->free_list = NULL;
+    pool->head = NULL;
+    pool->end = NULL;
+    pool->blocks = NULL;
+}
+
+void *nodepool_grow(NodePool *pool) {
+    NodePoolBlock *block;
+    char *nodes;
+
+    block = allocator_alloc(pool->alloc, block_size(pool), 0);
+    if (!block)
+        return NULL;
+    block->next = pool->blocks;
+    pool->blocks = block;
+
+    nodes = ((char *)block) + BLOCK_HEADER;
+    pool->head = nodes + pool->node_size;
+    pool->end = nodes + pool->node_size * pool->block_nodes;
+
+    return nodes;
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+/**
+ * @file node_pool.h
+ */
+
+#ifndef __NODE_POOL_H__
+#define __NODE_POOL_H__
+
+#include <stdlib.h>
+
+#include "allocator.h"
+
+/**
+ * @brief default number of nodes per block
+ */
+#define NODEPOOL_BLOCK_NODES (256)
+
+/**
+ * @brief block of nodes, followed by the nodes
+ */
+typedef struct NodePoolBlock {
+    struct NodePoolBlock *next; /**< the block allocated before */
+} NodePoolBlock;
+
+/**
+ * @brief slab of fixed-size nodes
+ *
+ * nodes are carved from blocks of contiguous nodes and recycled through an intrusive free list,
+ * so allocating and releasing a node doesn't call the allocator.
+ * the blocks are given back only all at once, by nodepool_free()
+ */
+typedef struct NodePool {
+    void *free_list;       /**< released nodes, each holding a pointer to the next */
+    char *head;            /**< next node never used, in the newest block */
+    char *end;             /**< end of the newest block */
+    NodePoolBlock *blocks; /**< the blocks, newest first */
+    size_t node_size;      /**< size of a node, rounded up to ALLOCATOR_ALIGNMENT */
+    size_t block_nodes;    /**< number of nodes per block */
+    Allocator *alloc;      /**< where the blocks come from */
+} NodePool;
+
+/**
+ * @brief initialize the pool, with NODEPOOL_BLOCK_NODES nodes per block
+ *
+ * @param pool NodePool
+ * @param node_size size of the nodes
+ * @param alloc Allocator for the blocks, if NULL allocator_std
+ */
+void nodepool_init(NodePool *pool, size_t node_size, Allocator *alloc);
+
+/**
+ * @brief initialize the pool, with @p block_nodes nodes per block
+ *
+ * @param pool NodePool
+ * @param node_size size of the nodes
+ * @param block_nodes number of nodes per block
+ * @param alloc Allocator for the blocks, if NULL allocator_std
+ */
+void nodepool_init_with(
+    NodePool *pool,
+    size_t node_size,
+    size_t block_nodes,
+    Allocator *alloc
+);
+
+/**
+ * @brief release all the blocks, invalidating every node
+ *
+ * the pool can be used again afterwards
+ *
+ * @param pool NodePool
+ */
+void nodepool_free(NodePool *pool);
+
+/**
+ * @brief allocate a block, when the pool runs out of nodes
+ *
+ * @param pool NodePool
+ * @return the first node of the new block
+ */
+void *nodepool_grow(NodePool *pool);
+
+/**
+ * @brief take a node from the pool
+ *
+ * @param pool NodePool
+ * @return uninitialized node, aligned to ALLOCATOR_ALIGNMENT
+ */
+inline void *nodepool_alloc(NodePool *pool) {
+    void *node;
+
+    if ((node = pool->free_list) != NULL) {
+        pool->free_list = *(void **)node;
+        return node;
+    }
+    if (pool->head < pool->end) {
+        node = pool->head;
+        pool->head += pool->node_size;
+        return node;
+    }
+    return nodepool_grow(pool);
+}
+
+/**
+ * @brief give a node back to the pool
+ *
+ * @param pool NodePool
+ * @param node node from nodepool_alloc()
+ */
+inline void nodepool_release(NodePool *pool, void *node) {
+    *(void **)node = pool->free_list;
+    pool->free_list = node;
+}
+
+#endif /* __NODE_POOL_H__ */
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "soa_vec.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline void soavec_truncate(SoaVec *v);
+extern inline void soavec_set_growth(SoaVec *v, Growth growth);
+extern inline void *soavec_column(SoaVec *v, size_t col);
+extern inline void *soavec_elem_at(SoaVec *v, size_t col, size_t pos);
+extern inline size_t soavec_len(SoaVec *v);
+extern inline bool soavec_is_empty(SoaVec *v);
+
+// capacity of the first allocation
+#define MIN_CAP (2UL)
+
+static inline char *soavec_ptr(SoaVec *v, size_t col, size_t pos) {
+    return ((char *)v->cols[col]) + (pos * v->szofs[col]);
+}
+
+/**
+ * @brief resize every column of SoaVec.
+ *
+ * if shrink, realloc by exact number
+ * if grow  , realloc by the Growth policy applied to whole records, otherwise exact number
+ *
+ * @param v SoaVec
+ * @param nelem number of records requested
+ */
+static void soavec_resize(SoaVec *v, size_t nelem) {
+    size_t col;
+
+    if (nelem > v->cap && v->row_szof) {
+        if (!v->cap && nelem < MIN_CAP)
+            nelem = MIN_CAP;
+        nelem = growth_next(v->growth, v->cap * v->row_szof, nelem * v->row_szof)
+            / v->row_szof;
+    }
+
+    for (col = 0; col < v->ncols; col++) {
+        if (v->cap)
+            v->cols[col] = allocator_realloc(
+                v->alloc,
+                v->cols[col],
+                v->cap * v->szofs[col],
+                nelem * v->szofs[col],
+                v->align
+            );
+        else
+            v->cols[col] = allocator_alloc(v->alloc, nelem * v->szofs[col], v->align);
+    }
+    v->cap = nelem;
+}
+
+int soavec_new(SoaVec *v, const size_t *szofs, size_t ncols) {
+    return soavec_new_in(v, szofs, ncols, NULL);
+}
+
+int soavec_new_in(SoaVec *v, const size_t *szofs, size_t ncols, Allocator *alloc) {
+    return soavec_new_aligned(v, szofs, ncols, 0, alloc);
+}
+
+int soavec_new_aligned(
+    SoaVec *v,
+    const size_t *szofs,
+    size_t ncols,
+    size_t align,
+    Allocator *alloc
+) {
+    size_t col;
+    int ret;
+
+    // an empty SoaVec on failure, so the column indices of the caller are out of bounds
+    ret = 0;
+    if (ncols > SOAVEC_MAX_COLS) {
+        ncols = 0;
+        ret = -1;
+    }
+
+    v->ncols = ncols;
+    v->row_szof = 0;
+    for (col = 0; col < ncols; col++) {
+        v->cols[col] = NULL;
+        v->szofs[col] = szofs[col];
+        v->row_szof += szofs[col];
+    }
+    v->cap = 0;
+    v->len = 0;
+    v->alloc = alloc ? alloc : &allocator_std;
+    v->align = align;
+    v->growth = GROWTH_2X;
+    return ret;
+}
+
+void soavec_free(SoaVec *v) {
+    size_t col;
+
+    if (v->cap) {
+        for (col = 0; col < v->ncols; col++) {
+            allocator_free(v->alloc, v->cols[col], v->cap * v->szofs[col]);
+            v->cols[col] = NULL;
+        }
+    }
+    v->cap = 0;
+    v->len = 0;
+}
+
+void soavec_reserve(SoaVec *v, size_t nelem) {
+    if (nelem > v->cap)
+        soavec_resize(v, nelem);
+}
+
+void soavec_shrink_to_fit(SoaVec *v) {
+    if (v->cap > v->len) {
+        if (v->len)
+            soavec_resize(v, v->len);
+        else
+            soavec_free(v);
+    }
+}
+
+void soavec_push(SoaVec *v, void *const *fields) {
+    size_t col;
+
+    if (v->len == v->cap)
+        soavec_reserve(v, v->len + 1);
+    for (col = 0; col < v->ncols; col++) {
+        if (fields[col])
+            memcpy(soavec_ptr(v, col, v->len), fields[col], v->szofs[col]);
+        else
+            memset(soavec_ptr(v, col, v->len), 0, v->szofs[col]);
+    }
+    v->len++;
+}
+
+size_t soavec_push_n_uninit(SoaVec *v, size_t nelem) {
+    size_t first;
+
+    soavec_reserve(v, v->len + nelem);
+    first = v->len;
+    v->len += nelem;
+
+    return first;
+}
+
+void soavec_get(SoaVec *v, size_t pos, void *const *fields) {
+    size_t col;
+
+    if (pos < v->len)
+        for (col = 0; col < v->ncols; col++)
+            if (fields[col])
+                memcpy(fields[col], soavec_ptr(v, col, pos), v->szofs[col]);
+}
+
+void soavec_set(SoaVec *v, size_t pos, void *const *fields) {
+    size_t col;
+
+    if (pos < v->len)
+        for (col = 0; col < v->ncols; col++)
+            if (fields[col])
+                memcpy(soavec_ptr(v, col, pos), fields[col], v->szofs[col]);
+}
+
+void soavec_pop(SoaVec *v, void *const *fields) {
+    if (v->len) {
+        if (fields)
+            soavec_get(v, v->len - 1, fields);
+        v->len--;
+    }
+}
+
+void soavec_swap_remove(SoaVec *v, size_t pos, void *const *fields) {
+    size_t col;
+
+    if (pos < v->len) {
+        if (fields)
+            soavec_get(v, pos, fields);
+        v->len--;
+        if (pos != v->len)
+            for (col = 0; col < v->ncols; col++)
+                memcpy(
+                    soavec_ptr(v, col, pos),
+                    soavec_ptr(v, col, v->len),
+                    v->szofs[col]
+                );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+/**
+ * @file soa_vec.h
+ */
+
+#ifndef __SOA_VEC_H__
+#define __SOA_VEC_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+#include "growth.h"
+
+/**
+ * @brief maximum number of columns of a SoaVec
+ */
+#define SOAVEC_MAX_COLS (16)
+
+/**
+ * @brief dynamic array stored as structure of arrays
+ *
+ * every field of the records is a column, a separate array; the columns share length and capacity.
+ * scanning one field touches only that field's memory
+ */
+typedef struct SoaVec {
+    void *cols[SOAVEC_MAX_COLS];  /**< the columns (if needed, access through soavec_column()) */
+    size_t szofs[SOAVEC_MAX_COLS]; /**< size of the elements of each column */
+    size_t ncols; /**< number of columns */
+    size_t cap; /**< number of records for which there is space allocated */
+    size_t len; /**< number of usable records */
+    size_t row_szof; /**< sum of the sizes of the columns' elements */
+    Allocator *alloc; /**< where the memory comes from */
+    size_t align; /**< alignment of the columns, 0 for the allocator's default */
+    Growth growth; /**< how the capacity grows */
+} SoaVec;
+
+/**
+ * @brief new SoaVec
+ *
+ * the SoaVec is not allocated, therefore soavec_column() returns NULL.
+ * more than SOAVEC_MAX_COLS columns are rejected, not truncated
+ *
+ * @param v SoaVec
+ * @param szofs sizes of the elements of each column
+ * @param ncols number of columns, at most SOAVEC_MAX_COLS
+ * @return 0 on success, -1 if @p ncols is more than SOAVEC_MAX_COLS, then the SoaVec has no columns
+ */
+int soavec_new(SoaVec *v, const size_t *szofs, size_t ncols);
+
+/**
+ * @brief new SoaVec, using @p alloc for its memory
+ *
+ * @param v SoaVec
+ * @param szofs sizes of the elements of each column
+ * @param ncols number of columns, at most SOAVEC_MAX_COLS
+ * @param alloc Allocator, NULL for allocator_std
+ * @return 0 on success, -1 if @p ncols is more than SOAVEC_MAX_COLS, then the SoaVec has no columns
+ */
+int soavec_new_in(SoaVec *v, const size_t *szofs, size_t ncols, Allocator *alloc);
+
+/**
+ * @brief new SoaVec, with every column aligned to @p align
+ *
+ * e.g. 32 or 64 for aligned SIMD loads on the columns
+ *
+ * @param v SoaVec
+ * @param szofs sizes of the elements of each column
+ * @param ncols number of columns, at most SOAVEC_MAX_COLS
+ * @param align alignment, a power of two, 0 for the allocator's default
+ * @param alloc Allocator, NULL for allocator_std
+ * @return 0 on success, -1 if @p ncols is more than SOAVEC_MAX_COLS, then the SoaVec has no columns
+ */
+int soavec_new_aligned(
+    SoaVec *v,
+    const size_t *szofs,
+    size_t ncols,
+    size_t align,
+    Allocator *alloc
+);
+
+/**
+ * @brief release memory
+ *
+ * doesn't reset the columns.
+ * if the single elements own memory, that needs to be release before by the caller
+ *
+ * @param v SoaVec
+ */
+void soavec_free(SoaVec *v);
+
+/**
+ * @brief empty the SoaVec but don't free the memory, so it can be reused
+ *
+ * @param v SoaVec
+ */
+inline void soavec_truncate(SoaVec *v) {
+    v->len = 0;
+}
+
+/**
+ * @brief change how the SoaVec grows
+ *
+ * the columns always grow together, by the size of a whole record
+ *
+ * @param v SoaVec
+ * @param growth Growth policy, GROWTH_2X by default
+ */
+inline void soavec_set_growth(SoaVec *v, Growth growth) {
+    v->growth = growth;
+}
+
+/**
+ * @brief reserve memory ahead of time
+ *
+ * @param v SoaVec
+ * @param nelem number of records to reserve memory for
+ */
+void soavec_reserve(SoaVec *v, size_t nelem);
+
+/**
+ * @brief shrink allocated memory to what is exactly needed for length
+ *
+ * @param v SoaVec
+ */
+void soavec_shrink_to_fit(SoaVec *v);
+
+/**
+ * @brief pointer to the elements of column @p col, or NULL
+ *
+ * the column is a plain array of soavec_len() elements, meant for tight loops.
+ * if changes to the SoaVec are made, this pointer can become invalid
+ *
+ * @param v SoaVec
+ * @param col index of the column
+ * @return pointer to the first element of the column
+ */
+inline void *soavec_column(SoaVec *v, size_t col) {
+    if (v->len && col < v->ncols)
+        return v->cols[col];
+    return NULL;
+}
+
+/**
+ * @brief pointer to the element of column @p col in record @p pos
+ *
+ * if changes to the SoaVec are made, this pointer can become invalid
+ *
+ * @param v SoaVec
+ * @param col index of the column
+ * @param pos index of the record
+ * @return pointer to the element, NULL if out of bounds
+ */
+inline void *soavec_elem_at(SoaVec *v, size_t col, size_t pos) {
+    if (pos < v->len && col < v->ncols)
+        return ((char *)v->cols[col]) + (pos * v->szofs[col]);
+    return NULL;
+}
+
+/**
+ * @brief number of records
+ *
+ * @param v SoaVec
+ * @return length
+ */
+inline size_t soavec_len(SoaVec *v) {
+    return v->len;
+}
+
+/**
+ * @brief if SoaVec is empty
+ *
+ * @param v SoaVec
+ * @return boolean
+ */
+inline bool soavec_is_empty(SoaVec *v) {
+    return v->len == 0;
+}
+
+/**
+ * @brief append a record through shallow-copy of its fields
+ *
+ * @param v SoaVec
+ * @param fields a pointer to the element of every column, a NULL field is zeroed
+ */
+void soavec_push(SoaVec *v, void *const *fields);
+
+/**
+ * @brief append @p nelem uninitialized records
+ *
+ * the caller writes them in place through soavec_elem_at() or the columns
+ *
+ * @param v SoaVec
+ * @param nelem number of records to append
+ * @return index of the first new record
+ */
+size_t soavec_push_n_uninit(SoaVec *v, size_t nelem);
+
+/**
+ * @brief gather the fields of record @p pos
+ *
+ * @param v SoaVec
+ * @param pos index of the record
+ * @param fields where to copy the element of every column, a NULL field is skipped
+ */
+void soavec_get(SoaVec *v, size_t pos, void *const *fields);
+
+/**
+ * @brief overwrite the fields of record @p pos
+ *
+ * @param v SoaVec
+ * @param pos index of the record
+ * @param fields a pointer to the element of every column, a NULL field is left unchanged
+ */
+void soavec_set(SoaVec *v, size_t pos, void *const *fields);
+
+/**
+ * @brief remove the last record
+ *
+ * doesn't deallocate memory
+ *
+ * @param v SoaVec
+ * @param fields where to copy the removed fields like soavec_get(), can be NULL
+ */
+void soavec_pop(SoaVec *v, void *const *fields);
+
+/**
+ * @brief remove record @p pos, replacing it with the last one
+ *
+ * O(1), but doesn't preserve the order of the records.
+ * doesn't deallocate memory
+ *
+ * @param v SoaVec
+ * @param pos index of the record
+ * @param fields where to copy the removed fields like soavec_get(), can be NULL
+ */
+void soavec_swap_remove(SoaVec *v, size_t pos, void *const *fields);
+
+#endif /* __SOA_VEC_H__ */
\ No newline at end of file
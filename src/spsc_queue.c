@@ -0,0 +1,134 @@
+#include "spsc_queue.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+static size_t round_pow2(size_t n) {
+    size_t pow2;
+
+    for (pow2 = 2; pow2 < n; pow2 <<= 1)
+        ;
+    return pow2;
+}
+
+static inline char *queue_ptr(SpscQueue *q, size_t pos) {
+    return q->buf + ((pos & q->mask) * q->szof);
+}
+
+int spscqueue_init(SpscQueue *q, size_t szof, size_t cap, Allocator *alloc) {
+    cap = round_pow2(cap);
+
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    q->tail_cache = 0;
+    q->head_cache = 0;
+    q->mask = cap - 1;
+    q->szof = szof;
+    q->alloc = alloc ? alloc : &allocator_std;
+    q->buf = allocator_alloc(q->alloc, cap * szof, 0);
+
+    return q->buf ? 0 : -1;
+}
+
+void spscqueue_free(SpscQueue *q) {
+    allocator_free(q->alloc, q->buf, (q->mask + 1) * q->szof);
+    q->buf = NULL;
+}
+
+// free slots for the producer, refreshing its copy of head only when it looks full
+static inline size_t producer_space(SpscQueue *q, size_t tail, size_t nelem) {
+    size_t space;
+
+    space = q->mask + 1 - (tail - q->head_cache);
+    if (space < nelem) {
+        q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+        space = q->mask + 1 - (tail - q->head_cache);
+    }
+    return space;
+}
+
+// elements ready for the consumer, refreshing its copy of tail only when it looks empty
+static inline size_t consumer_ready(SpscQueue *q, size_t head, size_t nelem) {
+    size_t ready;
+
+    ready = q->tail_cache - head;
+    if (ready < nelem) {
+        q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+        ready = q->tail_cache - head;
+    }
+    return ready;
+}
+
+bool spscqueue_push(SpscQueue *q, const void *elem) {
+    size_t tail;
+
+    tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (!producer_space(q, tail, 1))
+        return false;
+
+    memcpy(queue_ptr(q, tail), elem, q->szof);
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+bool spscqueue_pop(SpscQueue *q, void *elem) {
+    size_t head;
+
+    head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (!consumer_ready(q, head, 1))
+        return false;
+
+    memcpy(elem, queue_ptr(q, head), q->szof);
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return true;
+}
+
+size_t spscqueue_push_n(SpscQueue *q, const void *elems, size_t nelem) {
+    size_t tail, space, first;
+
+    tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    space = producer_space(q, tail, nelem);
+    if (nelem > space)
+        nelem = space;
+    if (!nelem)
+        return 0;
+
+    // up to the end of the buffer, then from its beginning
+    first = q->mask + 1 - (tail & q->mask);
+    if (first > nelem)
+        first = nelem;
+    memcpy(queue_ptr(q, tail), elems, first * q->szof);
+    memcpy(q->buf, ((const char *)elems) + (first * q->szof), (nelem - first) * q->szof);
+
+    atomic_store_explicit(&q->tail, tail + nelem, memory_order_release);
+    return nelem;
+}
+
+size_t spscqueue_pop_n(SpscQueue *q, void *elems, size_t nelem) {
+    size_t head, ready, first;
+
+    head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    ready = consumer_ready(q, head, nelem);
+    if (nelem > ready)
+        nelem = ready;
+    if (!nelem)
+        return 0;
+
+    first = q->mask + 1 - (head & q->mask);
+    if (first > nelem)
+        first = nelem;
+    memcpy(elems, queue_ptr(q, head), first * q->szof);
+    memcpy(((char *)elems) + (first * q->szof), q->buf, (nelem - first) * q->szof);
+
+    atomic_store_explicit(&q->head, head + nelem, memory_order_release);
+    return nelem;
+}
+
+size_t spscqueue_len(SpscQueue *q) {
+    size_t head, tail;
+
+    head = atomic_load_explicit(&q->head, memory_order_acquire);
+    tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    return tail - head;
+}
\ No newline at end of file
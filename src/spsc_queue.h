@@ -0,0 +1,106 @@
+/**
+ * @file spsc_queue.h
+ */
+
+#ifndef __SPSC_QUEUE_H__
+#define __SPSC_QUEUE_H__
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+
+/**
+ * @brief size of a cache line, what the indices shared between threads are padded to
+ */
+#define QUEUE_CACHE_LINE (64)
+
+/**
+ * @brief bounded lock-free queue, for one producer thread and one consumer thread
+ *
+ * a ring buffer of elements of szof bytes, like Vec's; the consumer's and the producer's index
+ * live on different cache lines, and each side caches the other's to touch it only when needed.
+ * the struct is aligned to QUEUE_CACHE_LINE, heap allocated ones need aligned_alloc()
+ */
+typedef struct SpscQueue {
+    alignas(QUEUE_CACHE_LINE) atomic_size_t head; /**< next element to pop, written by the consumer */
+    size_t tail_cache;                            /**< the consumer's copy of tail */
+    alignas(QUEUE_CACHE_LINE) atomic_size_t tail; /**< next element to push, written by the producer */
+    size_t head_cache;                            /**< the producer's copy of head */
+    alignas(QUEUE_CACHE_LINE) char *buf;          /**< the elements */
+    size_t mask;                                  /**< capacity - 1, the capacity is a power of two */
+    size_t szof;                                  /**< sizeof() of the data type to be held */
+    Allocator *alloc;                             /**< where the memory comes from */
+} SpscQueue;
+
+/**
+ * @brief initialize the queue
+ *
+ * @param q SpscQueue
+ * @param szof size of the single elements it's going to contain
+ * @param cap minimum number of elements, rounded up to a power of two
+ * @param alloc Allocator, NULL for allocator_std
+ * @return 0 on success, -1 if the memory can't be allocated
+ */
+int spscqueue_init(SpscQueue *q, size_t szof, size_t cap, Allocator *alloc);
+
+/**
+ * @brief release memory
+ *
+ * no thread may be using the queue
+ *
+ * @param q SpscQueue
+ */
+void spscqueue_free(SpscQueue *q);
+
+/**
+ * @brief append an element through shallow-copy, from the producer
+ *
+ * @param q SpscQueue
+ * @param elem element to insert
+ * @return false if the queue is full
+ */
+bool spscqueue_push(SpscQueue *q, const void *elem);
+
+/**
+ * @brief remove the oldest element, from the consumer
+ *
+ * @param q SpscQueue
+ * @param elem where to copy the element removed
+ * @return false if the queue is empty
+ */
+bool spscqueue_pop(SpscQueue *q, void *elem);
+
+/**
+ * @brief append as many elements as fit, from the producer
+ *
+ * the elements are published together, copied in at most two segments
+ *
+ * @param q SpscQueue
+ * @param elems array of elements
+ * @param nelem number of elements of the array
+ * @return number of elements inserted
+ */
+size_t spscqueue_push_n(SpscQueue *q, const void *elems, size_t nelem);
+
+/**
+ * @brief remove up to @p nelem of the oldest elements, from the consumer
+ *
+ * @param q SpscQueue
+ * @param elems where to copy the elements removed
+ * @param nelem maximum number of elements to remove
+ * @return number of elements removed
+ */
+size_t spscqueue_pop_n(SpscQueue *q, void *elems, size_t nelem);
+
+/**
+ * @brief number of elements, only a snapshot while the other side is working
+ *
+ * @param q SpscQueue
+ * @return length
+ */
+size_t spscqueue_len(SpscQueue *q);
+
+#endif /* __SPSC_QUEUE_H__ */
\ No newline at end of file
@@ -1,41 +1,167 @@
 #include "sstr.h"
 
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define GROWTH_FACTOR (2UL)
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline bool sstr_is_heap(SStr *s);
+extern inline size_t sstr_len(SStr *s);
+extern inline char *sstr_data(SStr *s);
+extern inline void sstr_truncate(SStr *s);
+extern inline void sstr_set_stats(SStr *s, Stats *stats);
+extern inline char *sstr_data_from(SStr *s, size_t pos);
+extern inline bool sstr_is_empty(SStr *s);
+extern inline SStrView sstrview_from_n(const char *ptr, size_t len);
+extern inline SStrView sstrview_from(const char *source);
+extern inline SStrView sstrview_from_sstr(SStr *s);
+extern inline SStrView sstrview_slice(SStrView v, size_t pos, size_t len);
+extern inline bool sstrview_eq(SStrView v1, SStrView v2);
+extern inline size_t sstr_find_char(SStr *s, char c, size_t pos);
+extern inline size_t sstr_find(SStr *s, const char *needle, size_t pos);
+extern inline size_t sstr_find_any(SStr *s, const char *set, size_t pos);
+extern inline size_t sstr_count_char(SStr *s, char c);
+extern inline SStrView sstrview_trim(SStrView v);
+
+// heap strings are preceded by their capacity
+#define HEAP_HEADER (sizeof(size_t))
+
+#define TAG(s) ((s)->u.buf[SSTR_INLINE_SIZE - 1])
+
+// sstr_catv() keeps up to this many lengths on the stack, past it they are computed again
+#define CATV_STACK_LENS (64)
+
+_Static_assert(SSTR_INLINE_CAP <= SSTR_TAG_LEN, "inline length must fit the tag");
 
 /********************************************************************************************
  *                                     PRIVATE METHODS                                      *
  ********************************************************************************************/
 
+inline static size_t s_cap(SStr *s) {
+    if (sstr_is_heap(s))
+        return ((size_t *)s->u.heap.ptr)[-1];
+    return SSTR_INLINE_CAP + 1;
+}
+
+inline static void s_set_len(SStr *s, size_t len) {
+    if (sstr_is_heap(s))
+        s->u.heap.len = len;
+    else
+        TAG(s) = (char)((TAG(s) & ~SSTR_TAG_LEN) | len);
+}
+
+inline static Growth s_growth(SStr *s) {
+    return (Growth)((unsigned char)TAG(s) >> SSTR_TAG_GROWTH_SHIFT);
+}
+
+inline static void s_set_inline(SStr *s) {
+    s->u.buf[0] = '\0';
+    TAG(s) = 0;
+}
+
+/**
+ * @brief move the inline string to the heap
+ */
 inline static void s_alloc(SStr *s, size_t nbytes) {
-    s->ptr = malloc(nbytes);
-    s->cap = nbytes;
+    char *base;
+    size_t len;
+
+    len = sstr_len(s);
+    base = allocator_alloc(s->alloc, HEAP_HEADER + nbytes, 0);
+    *(size_t *)base = nbytes;
+    memcpy(base + HEAP_HEADER, s->u.buf, len + 1);
+
+    s->u.heap.ptr = base + HEAP_HEADER;
+    s->u.heap.len = len;
+    TAG(s) = (char)((TAG(s) & ~SSTR_TAG_LEN) | SSTR_TAG_HEAP);
+    STATS_RECORD(s->stats, STATS_ALLOC, len + 1, HEAP_HEADER + nbytes);
 }
 
 inline static void s_realloc(SStr *s, size_t nbytes) {
-    s->ptr = realloc(s->ptr, nbytes);
-    s->cap = nbytes;
+    char *base;
+#ifdef CCOLL_STATS
+    size_t cap = s_cap(s);
+#endif
+
+    base = allocator_realloc(
+        s->alloc,
+        s->u.heap.ptr - HEAP_HEADER,
+        HEAP_HEADER + s_cap(s),
+        HEAP_HEADER + nbytes,
+        0
+    );
+    STATS_RECORD(
+        s->stats,
+        STATS_REALLOC,
+        base != s->u.heap.ptr - HEAP_HEADER
+            ? HEAP_HEADER + (nbytes < cap ? nbytes : cap)
+            : 0,
+        HEAP_HEADER + nbytes
+    );
+    *(size_t *)base = nbytes;
+    s->u.heap.ptr = base + HEAP_HEADER;
+}
+
+/**
+ * @brief release the heap string, copying its first @p len characters inline
+ */
+inline static void s_dealloc(SStr *s, size_t len) {
+    char *ptr;
+    size_t cap;
+
+    ptr = s->u.heap.ptr;
+    cap = s_cap(s);
+
+    memcpy(s->u.buf, ptr, len);
+    s->u.buf[len] = '\0';
+    TAG(s) = (char)((TAG(s) & ~(SSTR_TAG_HEAP | SSTR_TAG_LEN)) | len);
+
+    allocator_free(s->alloc, ptr - HEAP_HEADER, HEAP_HEADER + cap);
+    STATS_RECORD(s->stats, STATS_FREE, len, HEAP_HEADER + cap);
+}
+
+/**
+ * @brief copy @p len characters of @p source at the end of @p s
+ *
+ * the space must have been reserved already
+ */
+inline static char *s_append(SStr *s, const char *source, size_t len) {
+    char *data;
+    size_t len_s;
+
+    len_s = sstr_len(s);
+    data = sstr_data(s);
+    memcpy(data + len_s, source, len);
+    data[len_s + len] = '\0';
+    s_set_len(s, len_s + len);
+
+    return data;
 }
 
 /**
  * @brief resize SStr.
  * 
- * if shrink, realloc by exact number
- * if grow  , realloc by GROWTH_FACTOR when possible, otherwise exact number
+ * if shrink, realloc by exact number, or move inline if it fits
+ * if grow  , realloc by the Growth policy when possible, otherwise exact number
  * 
  * @param s SStr
  * @param nbytes number of bytes required
  */
 static void sstr_resize(SStr *s, size_t nbytes) {
-    if (s->cap) {
-        if (nbytes < s->cap || nbytes > s->cap * GROWTH_FACTOR)
+    size_t cap;
+
+    cap = s_cap(s);
+    if (sstr_is_heap(s)) {
+        if (nbytes <= SSTR_INLINE_CAP + 1)
+            s_dealloc(s, s->u.heap.len);
+        else if (nbytes < cap)
             s_realloc(s, nbytes);
-        else if (nbytes > s->cap)
-            s_realloc(s, s->cap * GROWTH_FACTOR);
-    } else {
-        s_alloc(s, nbytes > GROWTH_FACTOR ? nbytes : GROWTH_FACTOR);
+        else if (nbytes > cap)
+            s_realloc(s, growth_next(s_growth(s), cap, nbytes));
+    } else if (nbytes > cap) {
+        s_alloc(s, growth_next(s_growth(s), cap, nbytes));
     }
 }
 
@@ -44,14 +170,18 @@ static void sstr_resize(SStr *s, size_t nbytes) {
  ********************************************************************************************/
 
 void sstr_new(SStr *s) {
-    s->cap = 0;
-    s->len = 0;
+    sstr_new_in(s, NULL);
+}
+
+void sstr_new_in(SStr *s, Allocator *alloc) {
+    s_set_inline(s);
+    s->alloc = alloc ? alloc : &allocator_std;
+    sstr_set_stats(s, NULL);
 }
 
 void sstr_new_with(SStr *s, size_t len) {
     sstr_new(s);
     sstr_reserve(s, len);
-    sstr_cpy(s, "");
 }
 
 void sstr_from(SStr *s, const char *source) {
@@ -60,61 +190,239 @@ void sstr_from(SStr *s, const char *source) {
 }
 
 void sstr_free(SStr *s) {
-    if (s->cap)
-        free(s->ptr);
-    s->cap = 0;
-    s->len = 0;
+    if (sstr_is_heap(s))
+        s_dealloc(s, 0);
+    else
+        sstr_truncate(s);
+}
+
+void sstr_set_growth(SStr *s, Growth growth) {
+    TAG(s) = (char)((TAG(s) & ~(~0U << SSTR_TAG_GROWTH_SHIFT))
+                    | ((unsigned)growth << SSTR_TAG_GROWTH_SHIFT));
 }
 
 void sstr_reserve(SStr *s, size_t len) {
-    if (len + 1 > s->cap)
+    if (len + 1 > s_cap(s))
         sstr_resize(s, len + 1);
 }
 
 void sstr_shrink_to_fit(SStr *s) {
-    if (s->cap > s->len + 1)
-        sstr_resize(s, s->len + 1);
+    if (s_cap(s) > sstr_len(s) + 1)
+        sstr_resize(s, sstr_len(s) + 1);
 }
 
 char *sstr_cpy(SStr *dest, const char *source) {
-    dest->len = strlen(source);
-    sstr_reserve(dest, dest->len);
-    return strcpy(dest->ptr, source);
+    size_t len;
+
+    len = strlen(source);
+    sstr_reserve(dest, len);
+    s_set_len(dest, len);
+    return strcpy(sstr_data(dest), source);
 }
 
 char *sstr_ncpy(SStr *dest, const char *source, size_t num) {
-    dest->len = strlen(source);
-    if (dest->len > num)
-        dest->len = num;
-    sstr_reserve(dest, dest->len);
-    dest->ptr[dest->len] = '\0';
-    return strncpy(dest->ptr, source, dest->len);
+    size_t len;
+    char *data;
+
+    len = strlen(source);
+    if (len > num)
+        len = num;
+    sstr_reserve(dest, len);
+    s_set_len(dest, len);
+    data = sstr_data(dest);
+    data[len] = '\0';
+    return strncpy(data, source, len);
 }
 
 char *sstr_cat(SStr *dest, const char *source) {
-    dest->len += strlen(source);
-    sstr_reserve(dest, dest->len);
-    return strcat(dest->ptr, source);
+    return sstr_cat_n(dest, source, strlen(source));
 }
 
 char *sstr_ncat(SStr *dest, const char *source, size_t num) {
-    size_t len_src;
+    const char *end;
+
+    if ((end = memchr(source, '\0', num)) != NULL)
+        num = (size_t)(end - source);
+    return sstr_cat_n(dest, source, num);
+}
+
+char *sstr_cat_n(SStr *dest, const char *source, size_t len) {
+    sstr_reserve(dest, sstr_len(dest) + len);
+    return s_append(dest, source, len);
+}
 
-    len_src = strlen(source);
-    if (len_src < num)
-        num = len_src;
-    dest->len += num;
-    sstr_reserve(dest, dest->len);
-    dest->ptr[dest->len] = '\0';
-    return strncat(dest->ptr, source, num);
+char *sstr_append_sstr(SStr *dest, SStr *source) {
+    // reserve first, in case dest == source
+    sstr_reserve(dest, sstr_len(dest) + sstr_len(source));
+    return s_append(dest, sstr_data(source), sstr_len(source));
 }
 
 char *sstr_merge(SStr *dest, SStr *source, const char *sep) {
-    if (source->len) {
-        dest->len += source->len + strlen(sep);
-        sstr_reserve(dest, dest->len);
-        strcat(strcat(dest->ptr, sep), source->ptr);
+    if (sstr_len(source)) {
+        size_t len_sep;
+
+        len_sep = strlen(sep);
+        sstr_reserve(dest, sstr_len(dest) + len_sep + sstr_len(source));
+        s_append(dest, sep, len_sep);
+        s_append(dest, sstr_data(source), sstr_len(source));
     }
     sstr_free(source);
-    return dest->ptr;
+    return sstr_data(dest);
+}
+
+char *sstr_catv(SStr *dest, const char **sources, size_t n, const char *sep) {
+    size_t lens[CATV_STACK_LENS];
+    size_t i, len, len_sep;
+    bool keep;
+
+    if (!n)
+        return sstr_data(dest);
+
+    // each source is scanned once if its length fits on the stack, otherwise twice.
+    // allocating from dest's allocator would stop dest from growing in place
+    keep = n <= CATV_STACK_LENS;
+
+    len_sep = strlen(sep);
+    len = sstr_len(dest) + (n - 1) * len_sep;
+    for (i = 0; i < n; i++) {
+        if (keep)
+            len += lens[i] = strlen(sources[i]);
+        else
+            len += strlen(sources[i]);
+    }
+    sstr_reserve(dest, len);
+
+    for (i = 0; i < n; i++) {
+        if (i)
+            s_append(dest, sep, len_sep);
+        s_append(dest, sources[i], keep ? lens[i] : strlen(sources[i]));
+    }
+
+    return sstr_data(dest);
+}
+
+char *sstr_join(SStr *dest, SStr *sources, size_t n, const char *sep) {
+    size_t i, len, len_sep;
+
+    if (!n)
+        return sstr_data(dest);
+
+    len_sep = strlen(sep);
+    len = sstr_len(dest) + (n - 1) * len_sep;
+    for (i = 0; i < n; i++)
+        len += sstr_len(&sources[i]);
+    sstr_reserve(dest, len);
+
+    for (i = 0; i < n; i++) {
+        if (i)
+            s_append(dest, sep, len_sep);
+        s_append(dest, sstr_data(&sources[i]), sstr_len(&sources[i]));
+    }
+
+    return sstr_data(dest);
+}
+
+char *sstr_catf(SStr *dest, const char *fmt, ...) {
+    va_list args;
+    char *data;
+
+    va_start(args, fmt);
+    data = sstr_vcatf(dest, fmt, args);
+    va_end(args);
+
+    return data;
+}
+
+char *sstr_vcatf(SStr *dest, const char *fmt, va_list args) {
+    va_list args_retry;
+    size_t len, avail;
+    int written;
+
+    len = sstr_len(dest);
+    avail = s_cap(dest) - len;
+
+    // first try to fit in the space left, most of the time no resize is needed
+    va_copy(args_retry, args);
+    written = vsnprintf(sstr_data(dest) + len, avail, fmt, args);
+
+    if (written >= 0 && (size_t)written >= avail) {
+        sstr_reserve(dest, len + (size_t)written);
+        written = vsnprintf(
+            sstr_data(dest) + len,
+            (size_t)written + 1,
+            fmt,
+            args_retry
+        );
+    }
+    va_end(args_retry);
+
+    if (written < 0) {
+        sstr_data(dest)[len] = '\0';
+        return NULL;
+    }
+
+    s_set_len(dest, len + (size_t)written);
+    return sstr_data(dest);
+}
+
+int sstrview_cmp(SStrView v1, SStrView v2) {
+    int cmp;
+
+    cmp = memcmp(v1.ptr, v2.ptr, v1.len < v2.len ? v1.len : v2.len);
+    if (cmp)
+        return cmp;
+    return (v1.len > v2.len) - (v1.len < v2.len);
+}
+
+bool sstrview_starts_with(SStrView v, SStrView prefix) {
+    return v.len >= prefix.len && memcmp(v.ptr, prefix.ptr, prefix.len) == 0;
+}
+
+bool sstrview_ends_with(SStrView v, SStrView suffix) {
+    return v.len >= suffix.len
+        && memcmp(v.ptr + v.len - suffix.len, suffix.ptr, suffix.len) == 0;
+}
+
+/**
+ * @brief take the token of length @p pos off @p rest, skipping @p skip characters of delimiter
+ */
+static inline void
+sv_split_at(SStrView *rest, size_t pos, size_t skip, SStrView *token) {
+    if (pos == SSTR_NPOS) {
+        *token = *rest;
+        rest->ptr = NULL;
+        rest->len = 0;
+    } else {
+        *token = sstrview_from_n(rest->ptr, pos);
+        rest->ptr += pos + skip;
+        rest->len -= pos + skip;
+    }
+}
+
+bool sstrview_split(SStrView *rest, char delim, SStrView *token) {
+    if (!rest->ptr)
+        return false;
+    sv_split_at(rest, sstrview_find_char(*rest, delim), 1, token);
+    return true;
+}
+
+bool sstrview_split_by(SStrView *rest, SStrView delim, SStrView *token) {
+    if (!rest->ptr)
+        return false;
+    sv_split_at(rest, sstrview_find(*rest, delim), delim.len, token);
+    return true;
+}
+
+SStrView sstrview_trim_left(SStrView v) {
+    while (v.len && isspace((unsigned char)*v.ptr)) {
+        v.ptr++;
+        v.len--;
+    }
+    return v;
+}
+
+SStrView sstrview_trim_right(SStrView v) {
+    while (v.len && isspace((unsigned char)v.ptr[v.len - 1]))
+        v.len--;
+    return v;
 }
\ No newline at end of file
@@ -5,31 +5,117 @@
 #ifndef __SSTR_H__
 #define __SSTR_H__
 
+#include <stdarg.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "allocator.h"
+#include "growth.h"
+#include "stats.h"
+
+/**
+ * @brief size of the inline buffer, same as a pointer, a capacity and a length
+ */
+#define SSTR_INLINE_SIZE (sizeof(char *) + 2 * sizeof(size_t))
+
+/**
+ * @brief max length of a string stored inline (the last 2 bytes are for the null-terminating char and the tag)
+ */
+#define SSTR_INLINE_CAP (SSTR_INLINE_SIZE - 2)
+
+/**
+ * @brief bit of the tag set when the string is on the heap
+ */
+#define SSTR_TAG_HEAP (0x20)
+
+/**
+ * @brief bits of the tag holding the length of an inline string
+ */
+#define SSTR_TAG_LEN (0x1F)
+
+/**
+ * @brief the bits of the tag from this one up hold the Growth policy
+ */
+#define SSTR_TAG_GROWTH_SHIFT (6)
 
 /**
  * @brief Dynamic string
+ *
+ * strings up to SSTR_INLINE_CAP characters are stored inline, longer ones on the heap.
+ * the tag is always the last byte of @p buf, and holds the inline length, SSTR_TAG_HEAP and the Growth policy
  */
 typedef struct SStr {
-    char *ptr;  /**< underlying c-style string (access through sstr_data()) */
-    size_t cap; /**< capacity allocated */
-    size_t len; /**< length of the SStr */
+    union {
+        struct {
+            char *ptr;  /**< underlying c-style string, preceded by its capacity */
+            size_t len; /**< length of the SStr */
+        } heap;
+        char buf[SSTR_INLINE_SIZE]; /**< underlying c-style string, followed by the tag */
+    } u; /**< access through sstr_data() and sstr_len() */
+    Allocator *alloc; /**< where the memory comes from */
+#ifdef CCOLL_STATS
+    Stats *stats; /**< where the allocations are counted */
+#endif
 } SStr;
 
+/**
+ * @brief if the string is stored on the heap
+ *
+ * @param s SStr
+ * @return boolean
+ */
+inline bool sstr_is_heap(SStr *s) {
+    return (unsigned char)s->u.buf[SSTR_INLINE_SIZE - 1] & SSTR_TAG_HEAP;
+}
+
+/**
+ * @brief length of the SStr
+ *
+ * @param s SStr
+ * @return number of characters, excluding the null-terminating one
+ */
+inline size_t sstr_len(SStr *s) {
+    if (sstr_is_heap(s))
+        return s->u.heap.len;
+    return (unsigned char)s->u.buf[SSTR_INLINE_SIZE - 1] & SSTR_TAG_LEN;
+}
+
+/**
+ * @brief return the underlying c-style string
+ *
+ * @param s SStr
+ * @return c-style string
+ */
+inline char *sstr_data(SStr *s) {
+    if (sstr_is_heap(s))
+        return s->u.heap.ptr;
+    return s->u.buf;
+}
+
 /**
  * @brief new SStr
  *
- * the SStr is not allocated, therefore sstr_data() returns NULL
+ * the SStr is empty and stored inline, sstr_data() is valid
  *
  * @param s SStr
  */
 void sstr_new(SStr *s);
 
+/**
+ * @brief new SStr whose memory comes from @p alloc
+ *
+ * the SStr is empty and stored inline, sstr_data() is valid
+ *
+ * @param s SStr
+ * @param alloc Allocator, if NULL allocator_std
+ */
+void sstr_new_in(SStr *s, Allocator *alloc);
+
 /**
  * @brief new SStr with reserved space
  *
- * the SStr has 0 length but is allocated, therefore sstr_data() is valid
+ * the SStr has 0 length, sstr_data() is valid
  *
  * @param s SStr
  * @param len minimum number of characters to reserve memory for
@@ -47,6 +133,8 @@ void sstr_from(SStr *s, const char *source);
 /**
  * @brief release memory
  *
+ * the SStr is left empty and can be reused
+ *
  * @param s SStr
  */
 void sstr_free(SStr *s);
@@ -57,38 +145,50 @@ void sstr_free(SStr *s);
  * @param s SStr
  */
 inline void sstr_truncate(SStr *s) {
-    if (s->len) {
-        *s->ptr = '\0';
-        s->len = 0;
-    }
+    *sstr_data(s) = '\0';
+    if (sstr_is_heap(s))
+        s->u.heap.len = 0;
+    else
+        s->u.buf[SSTR_INLINE_SIZE - 1] &= ~SSTR_TAG_LEN;
 }
 
 /**
- * @brief reserve memory ahead of time
+ * @brief change how the SStr grows
  *
  * @param s SStr
- * @param len minimum number of characters to reserve memory for
+ * @param growth Growth policy, GROWTH_2X by default
  */
-void sstr_reserve(SStr *s, size_t len);
+void sstr_set_growth(SStr *s, Growth growth);
 
 /**
- * @brief shrink allocated memory to what is exactly needed for length
+ * @brief count the allocations of the SStr in @p stats, nothing without CCOLL_STATS
  *
  * @param s SStr
+ * @param stats registered Stats, NULL for stats_sstr
  */
-void sstr_shrink_to_fit(SStr *s);
+inline void sstr_set_stats(SStr *s, Stats *stats) {
+#ifdef CCOLL_STATS
+    s->stats = stats ? stats : &stats_sstr;
+#else
+    (void)s;
+    (void)stats;
+#endif
+}
 
 /**
- * @brief return the underlying c-style string, or NULL
+ * @brief reserve memory ahead of time
  *
  * @param s SStr
- * @return c-style string or NULL
+ * @param len minimum number of characters to reserve memory for
  */
-inline char *sstr_data(SStr *s) {
-    if (s->cap)  // len could be 0, but still allocated because of the null-terminating character
-        return s->ptr;
-    return NULL;
-}
+void sstr_reserve(SStr *s, size_t len);
+
+/**
+ * @brief shrink allocated memory to what is exactly needed for length
+ *
+ * @param s SStr
+ */
+void sstr_shrink_to_fit(SStr *s);
 
 /**
  * @brief return the underlying c-style string starting at @p pos, or NULL
@@ -98,9 +198,9 @@ inline char *sstr_data(SStr *s) {
  * @return c-style string or NULL
  */
 inline char *sstr_data_from(SStr *s, size_t pos) {
-    // asking for the position from the null-terminating char is valid, so i hate to check s->cap too
-    if (pos <= s->len && s->cap)
-        return s->ptr + pos;
+    // asking for the position from the null-terminating char is valid
+    if (pos <= sstr_len(s))
+        return sstr_data(s) + pos;
     return NULL;
 }
 
@@ -142,6 +242,29 @@ char *sstr_cat(SStr *dest, const char *source);
  */
 char *sstr_ncat(SStr *dest, const char *source, size_t num);
 
+/**
+ * @brief append exactly @p len characters of @p source
+ *
+ * doesn't need @p source to be null-terminated, nor scans it
+ *
+ * @param dest SStr
+ * @param source source characters
+ * @param len number of characters to append
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_cat_n(SStr *dest, const char *source, size_t len);
+
+/**
+ * @brief append @p source to @p dest
+ *
+ * unlike sstr_merge(), @p source isn't consumed, and can be @p dest itself
+ *
+ * @param dest SStr
+ * @param source SStr to append
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_append_sstr(SStr *dest, SStr *source);
+
 /**
  * @brief merge two SStr
  *
@@ -153,6 +276,56 @@ char *sstr_ncat(SStr *dest, const char *source, size_t num);
  */
 char *sstr_merge(SStr *dest, SStr *source, const char *sep);
 
+/**
+ * @brief append the c-style strings @p sources, with @p sep in between
+ *
+ * the total length is computed first, so @p dest is resized at most once
+ *
+ * @param dest SStr
+ * @param sources array of c-style strings
+ * @param n number of strings in @p sources
+ * @param sep c-style string to put in between
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_catv(SStr *dest, const char **sources, size_t n, const char *sep);
+
+/**
+ * @brief append the SStrs @p sources, with @p sep in between
+ *
+ * the total length is computed first, so @p dest is resized at most once.
+ * @p sources aren't consumed, and must not contain @p dest
+ *
+ * @param dest SStr
+ * @param sources array of SStr
+ * @param n number of SStr in @p sources
+ * @param sep c-style string to put in between
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_join(SStr *dest, SStr *sources, size_t n, const char *sep);
+
+/**
+ * @brief sprintf at the end of the SStr
+ *
+ * formats directly into the free space, and resizes only if it doesn't fit
+ *
+ * @param dest SStr
+ * @param fmt printf-style format
+ * @return the underlying c-style string of @p dest, or NULL on a formatting error (@p dest is left unchanged)
+ */
+char *sstr_catf(SStr *dest, const char *fmt, ...);
+
+/**
+ * @brief vsprintf at the end of the SStr
+ *
+ * see sstr_catf()
+ *
+ * @param dest SStr
+ * @param fmt printf-style format
+ * @param args arguments of @p fmt
+ * @return the underlying c-style string of @p dest, or NULL on a formatting error (@p dest is left unchanged)
+ */
+char *sstr_vcatf(SStr *dest, const char *fmt, va_list args);
+
 /**
  * @brief if SStr is empty
  *
@@ -160,7 +333,277 @@ char *sstr_merge(SStr *dest, SStr *source, const char *sep);
  * @return boolean
  */
 inline bool sstr_is_empty(SStr *s) {
-    return s->len == 0;
+    return sstr_len(s) == 0;
+}
+
+/**
+ * @brief returned by the find functions when there's no match
+ */
+#define SSTR_NPOS ((size_t)-1)
+
+/**
+ * @brief non-owning view of a string
+ *
+ * doesn't need to be null-terminated. a NULL @p ptr marks a view exhausted by sstrview_split()
+ */
+typedef struct SStrView {
+    const char *ptr; /**< beginning of the characters */
+    size_t len;      /**< number of characters */
+} SStrView;
+
+/**
+ * @brief view of @p len characters starting at @p ptr
+ *
+ * @param ptr characters
+ * @param len number of characters
+ * @return SStrView
+ */
+inline SStrView sstrview_from_n(const char *ptr, size_t len) {
+    SStrView v;
+
+    v.ptr = ptr;
+    v.len = len;
+    return v;
+}
+
+/**
+ * @brief view of a c-style string
+ *
+ * @param source c-style string
+ * @return SStrView
+ */
+inline SStrView sstrview_from(const char *source) {
+    return sstrview_from_n(source, strlen(source));
+}
+
+/**
+ * @brief view of a SStr
+ *
+ * if @p s is modified, the view can become invalid
+ *
+ * @param s SStr
+ * @return SStrView
+ */
+inline SStrView sstrview_from_sstr(SStr *s) {
+    return sstrview_from_n(sstr_data(s), sstr_len(s));
+}
+
+/**
+ * @brief view of @p len characters starting at @p pos
+ *
+ * both are clamped to the size of @p v
+ *
+ * @param v SStrView
+ * @param pos start position
+ * @param len number of characters
+ * @return SStrView
+ */
+inline SStrView sstrview_slice(SStrView v, size_t pos, size_t len) {
+    if (pos > v.len)
+        pos = v.len;
+    if (len > v.len - pos)
+        len = v.len - pos;
+    return sstrview_from_n(v.ptr + pos, len);
+}
+
+/**
+ * @brief if @p v1 and @p v2 contain the same characters
+ *
+ * @param v1 SStrView
+ * @param v2 SStrView
+ * @return boolean
+ */
+inline bool sstrview_eq(SStrView v1, SStrView v2) {
+    return v1.len == v2.len && memcmp(v1.ptr, v2.ptr, v1.len) == 0;
+}
+
+/**
+ * @brief compare two SStrView like strcmp
+ *
+ * @param v1 SStrView
+ * @param v2 SStrView
+ * @return <0, 0 or >0 if @p v1 is less, equal or greater than @p v2
+ */
+int sstrview_cmp(SStrView v1, SStrView v2);
+
+/**
+ * @brief if @p v begins with @p prefix
+ *
+ * @param v SStrView
+ * @param prefix SStrView
+ * @return boolean
+ */
+bool sstrview_starts_with(SStrView v, SStrView prefix);
+
+/**
+ * @brief if @p v ends with @p suffix
+ *
+ * @param v SStrView
+ * @param suffix SStrView
+ * @return boolean
+ */
+bool sstrview_ends_with(SStrView v, SStrView suffix);
+
+/**
+ * @brief position of the first @p c in @p v
+ *
+ * uses memchr(), the other search functions are SSE2/AVX2 accelerated where available
+ *
+ * @param v SStrView
+ * @param c character to find
+ * @return position, or SSTR_NPOS
+ */
+size_t sstrview_find_char(SStrView v, char c);
+
+/**
+ * @brief position of the first occurrence of @p needle in @p v
+ *
+ * @param v SStrView
+ * @param needle SStrView to find
+ * @return position, or SSTR_NPOS. an empty @p needle is found at 0
+ */
+size_t sstrview_find(SStrView v, SStrView needle);
+
+/**
+ * @brief position of the first character of @p v that is in @p set
+ *
+ * fastest with up to 16 characters in @p set
+ *
+ * @param v SStrView
+ * @param set characters to find
+ * @return position, or SSTR_NPOS
+ */
+size_t sstrview_find_any(SStrView v, SStrView set);
+
+/**
+ * @brief number of occurrences of @p c in @p v
+ *
+ * @param v SStrView
+ * @param c character to count
+ * @return count
+ */
+size_t sstrview_count_char(SStrView v, char c);
+
+/**
+ * @brief split the next token off @p rest, on @p delim
+ *
+ * iterate with `while (sstrview_split(&rest, ',', &token))`.
+ * "a,,b" gives "a", "" and "b". when the last token is taken @p rest is exhausted (NULL ptr)
+ *
+ * @param rest SStrView to split, advanced past the token and the delimiter
+ * @param delim delimiter
+ * @param token the token, a view into @p rest
+ * @return false if @p rest was already exhausted
+ */
+bool sstrview_split(SStrView *rest, char delim, SStrView *token);
+
+/**
+ * @brief split the next token off @p rest, on the string @p delim
+ *
+ * see sstrview_split()
+ *
+ * @param rest SStrView to split, advanced past the token and the delimiter
+ * @param delim delimiter, must not be empty
+ * @param token the token, a view into @p rest
+ * @return false if @p rest was already exhausted
+ */
+bool sstrview_split_by(SStrView *rest, SStrView delim, SStrView *token);
+
+/**
+ * @brief position of the first @p c in @p s, starting at @p pos
+ *
+ * @param s SStr
+ * @param c character to find
+ * @param pos start position
+ * @return position, or SSTR_NPOS
+ */
+inline size_t sstr_find_char(SStr *s, char c, size_t pos) {
+    size_t found;
+
+    if (pos > sstr_len(s))
+        return SSTR_NPOS;
+    found = sstrview_find_char(
+        sstrview_from_n(sstr_data(s) + pos, sstr_len(s) - pos),
+        c
+    );
+    return found == SSTR_NPOS ? SSTR_NPOS : pos + found;
+}
+
+/**
+ * @brief position of the first occurrence of @p needle in @p s, starting at @p pos
+ *
+ * @param s SStr
+ * @param needle c-style string to find
+ * @param pos start position
+ * @return position, or SSTR_NPOS
+ */
+inline size_t sstr_find(SStr *s, const char *needle, size_t pos) {
+    size_t found;
+
+    if (pos > sstr_len(s))
+        return SSTR_NPOS;
+    found = sstrview_find(
+        sstrview_from_n(sstr_data(s) + pos, sstr_len(s) - pos),
+        sstrview_from(needle)
+    );
+    return found == SSTR_NPOS ? SSTR_NPOS : pos + found;
+}
+
+/**
+ * @brief position of the first character of @p s in @p set, starting at @p pos
+ *
+ * @param s SStr
+ * @param set c-style string of the characters to find
+ * @param pos start position
+ * @return position, or SSTR_NPOS
+ */
+inline size_t sstr_find_any(SStr *s, const char *set, size_t pos) {
+    size_t found;
+
+    if (pos > sstr_len(s))
+        return SSTR_NPOS;
+    found = sstrview_find_any(
+        sstrview_from_n(sstr_data(s) + pos, sstr_len(s) - pos),
+        sstrview_from(set)
+    );
+    return found == SSTR_NPOS ? SSTR_NPOS : pos + found;
+}
+
+/**
+ * @brief number of occurrences of @p c in @p s
+ *
+ * @param s SStr
+ * @param c character to count
+ * @return count
+ */
+inline size_t sstr_count_char(SStr *s, char c) {
+    return sstrview_count_char(sstrview_from_sstr(s), c);
+}
+
+/**
+ * @brief @p v without leading whitespace
+ *
+ * @param v SStrView
+ * @return SStrView
+ */
+SStrView sstrview_trim_left(SStrView v);
+
+/**
+ * @brief @p v without trailing whitespace
+ *
+ * @param v SStrView
+ * @return SStrView
+ */
+SStrView sstrview_trim_right(SStrView v);
+
+/**
+ * @brief @p v without leading and trailing whitespace
+ *
+ * @param v SStrView
+ * @return SStrView
+ */
+inline SStrView sstrview_trim(SStrView v) {
+    return sstrview_trim_right(sstrview_trim_left(v));
 }
 
 #endif /* __SSTR_H__ */
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include "sstr.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// SSE2 is part of x86-64, AVX2 is compiled per-function and picked at runtime
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define SSTR_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+// past this many characters find_any falls back to a lookup table
+#define FIND_ANY_SIMD_MAX (16)
+
+/********************************************************************************************
+ *                                         SCALAR                                           *
+ ********************************************************************************************/
+
+static size_t find_char_scalar(const char *p, size_t len, char c) {
+    const char *found;
+
+    if (len && (found = memchr(p, c, len)) != NULL)
+        return (size_t)(found - p);
+    return SSTR_NPOS;
+}
+
+static size_t count_char_scalar(const char *p, size_t len, char c) {
+    size_t i, count;
+
+    count = 0;
+    for (i = 0; i < len; i++)
+        count += p[i] == c;
+    return count;
+}
+
+static size_t
+find_any_scalar(const char *p, size_t len, const char *set, size_t nset) {
+    bool table[256] = {false};
+    size_t i;
+
+    for (i = 0; i < nset; i++)
+        table[(unsigned char)set[i]] = true;
+    for (i = 0; i < len; i++)
+        if (table[(unsigned char)p[i]])
+            return i;
+    return SSTR_NPOS;
+}
+
+static size_t
+find_scalar(const char *p, size_t len, const char *needle, size_t nlen) {
+    const char *curr, *last;
+
+    if (len < nlen)
+        return SSTR_NPOS;
+
+    // candidates are the occurrences of the first character
+    curr = p;
+    last = p + len - nlen;
+    while (curr <= last
+           && (curr = memchr(curr, needle[0], (size_t)(last - curr) + 1))) {
+        if (memcmp(curr + 1, needle + 1, nlen - 1) == 0)
+            return (size_t)(curr - p);
+        curr++;
+    }
+
+    return SSTR_NPOS;
+}
+
+#ifdef SSTR_SIMD_X86
+
+/********************************************************************************************
+ *                                          SSE2                                            *
+ ********************************************************************************************/
+
+static size_t count_char_sse2(const char *p, size_t len, char c) {
+    __m128i needle, acc, total;
+    size_t i, count;
+    int j;
+
+    needle = _mm_set1_epi8(c);
+    total = _mm_setzero_si128();
+    for (i = 0; i + 16 <= len;) {
+        // a match is -1, so subtracting counts it. flush before the bytes overflow
+        acc = _mm_setzero_si128();
+        for (j = 0; j < 255 && i + 16 <= len; j++, i += 16)
+            acc = _mm_sub_epi8(
+                acc,
+                _mm_cmpeq_epi8(
+                    _mm_loadu_si128((const __m128i *)(p + i)),
+                    needle
+                )
+            );
+        total = _mm_add_epi64(total, _mm_sad_epu8(acc, _mm_setzero_si128()));
+    }
+
+    count = (size_t)_mm_cvtsi128_si64(total)
+        + (size_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(total, total));
+    return count + count_char_scalar(p + i, len - i, c);
+}
+
+static size_t
+find_any_sse2(const char *p, size_t len, const char *set, size_t nset) {
+    __m128i needles[FIND_ANY_SIMD_MAX], block, eq;
+    size_t i, k, found;
+    int mask;
+
+    for (k = 0; k < nset; k++)
+        needles[k] = _mm_set1_epi8(set[k]);
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        block = _mm_loadu_si128((const __m128i *)(p + i));
+        eq = _mm_cmpeq_epi8(block, needles[0]);
+        for (k = 1; k < nset; k++)
+            eq = _mm_or_si128(eq, _mm_cmpeq_epi8(block, needles[k]));
+        if ((mask = _mm_movemask_epi8(eq)) != 0)
+            return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+
+    found = find_any_scalar(p + i, len - i, set, nset);
+    return found == SSTR_NPOS ? SSTR_NPOS : i + found;
+}
+
+/* compare first and last character of the needle at every position,
+ * and only memcmp where both match */
+static size_t
+find_sse2(const char *p, size_t len, const char *needle, size_t nlen) {
+    __m128i first, last, eq;
+    size_t i, found;
+    unsigned mask;
+
+    first = _mm_set1_epi8(needle[0]);
+    last = _mm_set1_epi8(needle[nlen - 1]);
+    for (i = 0; i + nlen - 1 + 16 <= len; i += 16) {
+        eq = _mm_and_si128(
+            _mm_cmpeq_epi8(first, _mm_loadu_si128((const __m128i *)(p + i))),
+            _mm_cmpeq_epi8(
+                last,
+                _mm_loadu_si128((const __m128i *)(p + i + nlen - 1))
+            )
+        );
+        mask = (unsigned)_mm_movemask_epi8(eq);
+        while (mask) {
+            found = i + (size_t)__builtin_ctz(mask);
+            if (memcmp(p + found + 1, needle + 1, nlen - 1) == 0)
+                return found;
+            mask &= mask - 1;
+        }
+    }
+
+    found = find_scalar(p + i, len - i, needle, nlen);
+    return found == SSTR_NPOS ? SSTR_NPOS : i + found;
+}
+
+/********************************************************************************************
+ *                                          AVX2                                            *
+ ********************************************************************************************/
+
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static size_t count_char_avx2(const char *p, size_t len, char c) {
+    __m256i needle, acc, total;
+    size_t i, count;
+    int j;
+
+    needle = _mm256_set1_epi8(c);
+    total = _mm256_setzero_si256();
+    for (i = 0; i + 32 <= len;) {
+        acc = _mm256_setzero_si256();
+        for (j = 0; j < 255 && i + 32 <= len; j++, i += 32)
+            acc = _mm256_sub_epi8(
+                acc,
+                _mm256_cmpeq_epi8(
+                    _mm256_loadu_si256((const __m256i *)(p + i)),
+                    needle
+                )
+            );
+        total = _mm256_add_epi64(
+            total,
+            _mm256_sad_epu8(acc, _mm256_setzero_si256())
+        );
+    }
+
+    count = (size_t)_mm256_extract_epi64(total, 0)
+        + (size_t)_mm256_extract_epi64(total, 1)
+        + (size_t)_mm256_extract_epi64(total, 2)
+        + (size_t)_mm256_extract_epi64(total, 3);
+    return count + count_char_sse2(p + i, len - i, c);
+}
+
+AVX2 static size_t
+find_any_avx2(const char *p, size_t len, const char *set, size_t nset) {
+    __m256i needles[FIND_ANY_SIMD_MAX], block, eq;
+    size_t i, k, found;
+    unsigned mask;
+
+    for (k = 0; k < nset; k++)
+        needles[k] = _mm256_set1_epi8(set[k]);
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        block = _mm256_loadu_si256((const __m256i *)(p + i));
+        eq = _mm256_cmpeq_epi8(block, needles[0]);
+        for (k = 1; k < nset; k++)
+            eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(block, needles[k]));
+        if ((mask = (unsigned)_mm256_movemask_epi8(eq)) != 0)
+            return i + (size_t)__builtin_ctz(mask);
+    }
+
+    found = find_any_sse2(p + i, len - i, set, nset);
+    return found == SSTR_NPOS ? SSTR_NPOS : i + found;
+}
+
+AVX2 static size_t
+find_avx2(const char *p, size_t len, const char *needle, size_t nlen) {
+    __m256i first, last, eq;
+    size_t i, found;
+    unsigned mask;
+
+    first = _mm256_set1_epi8(needle[0]);
+    last = _mm256_set1_epi8(needle[nlen - 1]);
+    for (i = 0; i + nlen - 1 + 32 <= len; i += 32) {
+        eq = _mm256_and_si256(
+            _mm256_cmpeq_epi8(
+                first,
+                _mm256_loadu_si256((const __m256i *)(p + i))
+            ),
+            _mm256_cmpeq_epi8(
+                last,
+                _mm256_loadu_si256((const __m256i *)(p + i + nlen - 1))
+            )
+        );
+        mask = (unsigned)_mm256_movemask_epi8(eq);
+        while (mask) {
+            found = i + (size_t)__builtin_ctz(mask);
+            if (memcmp(p + found + 1, needle + 1, nlen - 1) == 0)
+                return found;
+            mask &= mask - 1;
+        }
+    }
+
+    found = find_sse2(p + i, len - i, needle, nlen);
+    return found == SSTR_NPOS ? SSTR_NPOS : i + found;
+}
+
+static inline bool has_avx2(void) {
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif /* SSTR_SIMD_X86 */
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+// libc's memchr is already vectorized, and beats a plain SIMD loop
+size_t sstrview_find_char(SStrView v, char c) {
+    return find_char_scalar(v.ptr, v.len, c);
+}
+
+size_t sstrview_count_char(SStrView v, char c) {
+#ifdef SSTR_SIMD_X86
+    if (has_avx2())
+        return count_char_avx2(v.ptr, v.len, c);
+    return count_char_sse2(v.ptr, v.len, c);
+#else
+    return count_char_scalar(v.ptr, v.len, c);
+#endif
+}
+
+size_t sstrview_find_any(SStrView v, SStrView set) {
+    if (!set.len)
+        return SSTR_NPOS;
+#ifdef SSTR_SIMD_X86
+    if (set.len <= FIND_ANY_SIMD_MAX) {
+        if (has_avx2())
+            return find_any_avx2(v.ptr, v.len, set.ptr, set.len);
+        return find_any_sse2(v.ptr, v.len, set.ptr, set.len);
+    }
+#endif
+    return find_any_scalar(v.ptr, v.len, set.ptr, set.len);
+}
+
+size_t sstrview_find(SStrView v, SStrView needle) {
+    if (!needle.len)
+        return 0;
+    if (needle.len > v.len)
+        return SSTR_NPOS;
+#ifdef SSTR_SIMD_X86
+    if (has_avx2())
+        return find_avx2(v.ptr, v.len, needle.ptr, needle.len);
+    return find_sse2(v.ptr, v.len, needle.ptr, needle.len);
+#else
+    return find_scalar(v.ptr, v.len, needle.ptr, needle.len);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "stats.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+Stats stats_vec = {.name = "vec"};
+Stats stats_sstr = {.name = "sstr", .next = &stats_vec};
+
+// new Stats are pushed in front, so the list can be read while another thread registers
+static _Atomic(Stats *) registry = &stats_sstr;
+
+static Func_StatsHook stats_hook = NULL;
+static void *stats_hook_ctx = NULL;
+
+static void stats_zero(Stats *stats) {
+    atomic_store_explicit(&stats->allocs, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->reallocs, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->frees, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->copied, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->moved, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->peak, 0, memory_order_relaxed);
+}
+
+void stats_register(Stats *stats, const char *name) {
+    Stats *head;
+
+    stats->name = name;
+    stats_zero(stats);
+    head = atomic_load_explicit(&registry, memory_order_relaxed);
+    do {
+        stats->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(
+        &registry, &head, stats, memory_order_release, memory_order_relaxed));
+}
+
+void stats_set_hook(Func_StatsHook hook, void *ctx) {
+    stats_hook = hook;
+    stats_hook_ctx = ctx;
+}
+
+void stats_record(Stats *stats, StatsEvent event, size_t bytes, size_t cap) {
+    size_t peak;
+
+    switch (event) {
+        case STATS_ALLOC:
+            atomic_fetch_add_explicit(&stats->allocs, 1, memory_order_relaxed);
+            break;
+        case STATS_REALLOC:
+            atomic_fetch_add_explicit(&stats->reallocs, 1, memory_order_relaxed);
+            break;
+        case STATS_FREE:
+            atomic_fetch_add_explicit(&stats->frees, 1, memory_order_relaxed);
+            break;
+        case STATS_MOVE:
+            atomic_fetch_add_explicit(&stats->moved, bytes, memory_order_relaxed);
+            break;
+    }
+    if (event != STATS_MOVE && bytes)
+        atomic_fetch_add_explicit(&stats->copied, bytes, memory_order_relaxed);
+
+    peak = atomic_load_explicit(&stats->peak, memory_order_relaxed);
+    while (cap > peak && !atomic_compare_exchange_weak_explicit(
+        &stats->peak, &peak, cap, memory_order_relaxed, memory_order_relaxed))
+        ;
+
+    if (stats_hook)
+        stats_hook(stats, event, bytes, cap, stats_hook_ctx);
+}
+
+void stats_reset(void) {
+    Stats *stats;
+
+    for (stats = atomic_load_explicit(&registry, memory_order_acquire); stats; stats = stats->next)
+        stats_zero(stats);
+}
+
+void stats_dump(FILE *f) {
+    Stats *stats;
+
+    fprintf(f, "%-16s %12s %12s %12s %14s %14s %14s\n",
+        "name", "allocs", "reallocs", "frees", "copied", "moved", "peak");
+    for (stats = atomic_load_explicit(&registry, memory_order_acquire); stats; stats = stats->next)
+        fprintf(f, "%-16s %12zu %12zu %12zu %14zu %14zu %14zu\n",
+            stats->name,
+            atomic_load_explicit(&stats->allocs, memory_order_relaxed),
+            atomic_load_explicit(&stats->reallocs, memory_order_relaxed),
+            atomic_load_explicit(&stats->frees, memory_order_relaxed),
+            atomic_load_explicit(&stats->copied, memory_order_relaxed),
+            atomic_load_explicit(&stats->moved, memory_order_relaxed),
+            atomic_load_explicit(&stats->peak, memory_order_relaxed));
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+ * @file stats.h
+ */
+
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief what happened to a container's memory
+ */
+typedef enum StatsEvent {
+    STATS_ALLOC,   /**< first allocation, bytes are the ones copied into it */
+    STATS_REALLOC, /**< capacity changed, bytes are the ones copied if the memory moved, 0 if in place */
+    STATS_FREE,    /**< memory released, bytes are the ones copied out of it */
+    STATS_MOVE,    /**< elements shifted by an insert or a remove, bytes are the ones moved */
+} StatsEvent;
+
+/**
+ * @brief counters of a group of containers
+ *
+ * Vecs report to stats_vec and SStrs to stats_sstr, unless given their own with vec_set_stats() / sstr_set_stats().
+ * the counters are only updated when the library is compiled with CCOLL_STATS defined
+ */
+typedef struct Stats {
+    const char *name; /**< name shown by stats_dump() */
+    atomic_size_t allocs; /**< number of STATS_ALLOC */
+    atomic_size_t reallocs; /**< number of STATS_REALLOC */
+    atomic_size_t frees; /**< number of STATS_FREE */
+    atomic_size_t copied; /**< bytes copied by allocations, reallocations and frees */
+    atomic_size_t moved; /**< bytes moved by inserts and removes */
+    atomic_size_t peak; /**< biggest capacity reached by a container, in bytes */
+    struct Stats *next; /**< next in the registry */
+} Stats;
+
+/**
+ * @brief called on every event, after the counters are updated
+ *
+ * @param stats Stats of the container
+ * @param event what happened
+ * @param bytes bytes copied or moved
+ * @param cap capacity of the container, in bytes
+ * @param ctx context given to stats_set_hook()
+ */
+typedef void (*Func_StatsHook)(Stats *stats, StatsEvent event, size_t bytes, size_t cap, void *ctx);
+
+/**
+ * @brief default Stats of the Vecs
+ */
+extern Stats stats_vec;
+
+/**
+ * @brief default Stats of the SStrs
+ */
+extern Stats stats_sstr;
+
+/**
+ * @brief reset @p stats and add it to the registry dumped by stats_dump()
+ *
+ * @p stats must outlive the containers using it, it's never removed from the registry
+ *
+ * @param stats Stats
+ * @param name name shown by stats_dump(), not copied
+ */
+void stats_register(Stats *stats, const char *name);
+
+/**
+ * @brief set the function called on every event
+ *
+ * not thread safe, set it before the containers are used
+ *
+ * @param hook function, NULL to remove it
+ * @param ctx context given to @p hook
+ */
+void stats_set_hook(Func_StatsHook hook, void *ctx);
+
+/**
+ * @brief count an event, use STATS_RECORD() so it compiles out without CCOLL_STATS
+ *
+ * @param stats Stats
+ * @param event what happened
+ * @param bytes bytes copied or moved
+ * @param cap capacity of the container, in bytes
+ */
+void stats_record(Stats *stats, StatsEvent event, size_t bytes, size_t cap);
+
+/**
+ * @brief zero the counters of every registered Stats
+ */
+void stats_reset(void);
+
+/**
+ * @brief print the counters of every registered Stats, one per line
+ *
+ * @param f where to print
+ */
+void stats_dump(FILE *f);
+
+/**
+ * @brief count an event in the hot path, nothing without CCOLL_STATS
+ *
+ * with CCOLL_STATS Vec and SStr get an extra field, so the library and its users must agree on it
+ */
+#ifdef CCOLL_STATS
+    #define STATS_RECORD(stats, event, bytes, cap) stats_record((stats), (event), (bytes), (cap))
+#else
+    #define STATS_RECORD(stats, event, bytes, cap) ((void)0)
+#endif
+
+#endif /* __STATS_H__ */
\ No newline at end of file
@@ -0,0 +1,128 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "thread_pool.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// takes and runs tasks until the job is over, with the lock held
+static void run_tasks(ThreadPool *pool) {
+    size_t task;
+
+    while (pool->next < pool->ntasks) {
+        task = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+        pool->func(pool->ctx, task);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0)
+            pthread_cond_signal(&pool->done);
+    }
+}
+
+static void *worker(void *arg) {
+    ThreadPool *pool;
+
+    pool = arg;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->stop && pool->next >= pool->ntasks)
+            pthread_cond_wait(&pool->work, &pool->lock);
+        if (pool->stop)
+            break;
+        run_tasks(pool);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+int threadpool_init(ThreadPool *pool, size_t nthreads) {
+    int err;
+
+    pool->threads = NULL;
+    pool->nthreads = 0;
+    pool->func = NULL;
+    pool->ctx = NULL;
+    pool->ntasks = 0;
+    pool->next = 0;
+    pool->pending = 0;
+    pool->stop = false;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_mutex_init(&pool->run, NULL);
+    pthread_cond_init(&pool->work, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    if (nthreads && (pool->threads = malloc(nthreads * sizeof(pthread_t))) == NULL)
+        goto fail;
+    for (; pool->nthreads < nthreads; pool->nthreads++) {
+        if ((err = pthread_create(&pool->threads[pool->nthreads], NULL, worker, pool))) {
+            errno = err;
+            goto fail;
+        }
+    }
+    return 0;
+
+fail:
+    err = errno;
+    threadpool_free(pool);
+    errno = err;
+    return -1;
+}
+
+void threadpool_free(ThreadPool *pool) {
+    size_t i;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+    for (i = 0; i < pool->nthreads; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    free(pool->threads);
+    pool->threads = NULL;
+    pool->nthreads = 0;
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->run);
+    pthread_cond_destroy(&pool->work);
+    pthread_cond_destroy(&pool->done);
+}
+
+static ThreadPool default_pool;
+static pthread_once_t default_once = PTHREAD_ONCE_INIT;
+
+static void default_init(void) {
+    long ncpus;
+
+    ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+    // without workers the jobs still run, on the calling thread
+    if (threadpool_init(&default_pool, ncpus > 1 ? (size_t)ncpus - 1 : 0) == -1)
+        threadpool_init(&default_pool, 0);
+}
+
+ThreadPool *threadpool_default(void) {
+    pthread_once(&default_once, default_init);
+    return &default_pool;
+}
+
+void threadpool_run(ThreadPool *pool, Func_Task func, void *ctx, size_t ntasks) {
+    if (!ntasks)
+        return;
+
+    pthread_mutex_lock(&pool->run);
+    pthread_mutex_lock(&pool->lock);
+    pool->func = func;
+    pool->ctx = ctx;
+    pool->ntasks = ntasks;
+    pool->next = 0;
+    pool->pending = ntasks;
+    pthread_cond_broadcast(&pool->work);
+
+    run_tasks(pool);
+    while (pool->pending)
+        pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->run);
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+/**
+ * @file thread_pool.h
+ */
+
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * @brief callback running one task of a job, with user context
+ */
+typedef void (*Func_Task)(void *ctx, size_t task);
+
+/**
+ * @brief fixed set of worker threads, reused by every job
+ *
+ * a job is a number of tasks, taken by the workers and the calling thread until none is left.
+ * needs to be linked with -pthread
+ */
+typedef struct ThreadPool {
+    pthread_t *threads;     /**< the workers */
+    size_t nthreads;        /**< number of workers */
+    pthread_mutex_t lock;   /**< protects the fields of the current job */
+    pthread_cond_t work;    /**< signalled when a job is posted, or the pool stops */
+    pthread_cond_t done;    /**< signalled when the last task of a job finishes */
+    pthread_mutex_t run;    /**< held by the thread running a job */
+    Func_Task func;         /**< the current job */
+    void *ctx;              /**< context of the current job */
+    size_t ntasks;          /**< number of tasks of the current job */
+    size_t next;            /**< next task to be taken */
+    size_t pending;         /**< tasks not finished yet */
+    bool stop;              /**< if the workers have to exit */
+} ThreadPool;
+
+/**
+ * @brief start @p nthreads workers
+ *
+ * with 0 workers, jobs run on the calling thread
+ *
+ * @param pool ThreadPool
+ * @param nthreads number of workers
+ * @return 0 on success, -1 on failure (errno is set)
+ */
+int threadpool_init(ThreadPool *pool, size_t nthreads);
+
+/**
+ * @brief stop and join the workers
+ *
+ * @param pool ThreadPool
+ */
+void threadpool_free(ThreadPool *pool);
+
+/**
+ * @brief the pool shared by the parallel algorithms, with a worker per online CPU but one
+ *
+ * started on first use, lives until the process exits
+ *
+ * @return ThreadPool
+ */
+ThreadPool *threadpool_default(void);
+
+/**
+ * @brief run @p func on every task in [0, @p ntasks) and wait for all of them
+ *
+ * the calling thread takes tasks too; jobs from different threads run one after another.
+ * @p func must not run jobs on the same pool
+ *
+ * @param pool ThreadPool
+ * @param func task callback
+ * @param ctx user context passed to @p func
+ * @param ntasks number of tasks
+ */
+void threadpool_run(ThreadPool *pool, Func_Task func, void *ctx, size_t ntasks);
+
+#endif /* __THREAD_POOL_H__ */
\ No newline at end of file
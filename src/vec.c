@@ -3,46 +3,99 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define GROWTH_FACTOR (2UL)
+// external definitions of the inline functions, for when the compiler doesn't inline them
+extern inline void vec_truncate(Vec *v);
+extern inline void vec_set_growth(Vec *v, Growth growth);
+extern inline void vec_set_stats(Vec *v, Stats *stats);
+extern inline void *vec_data(Vec *v);
+extern inline void *vec_elem_at(Vec *v, size_t pos);
+extern inline void vec_push(Vec *v, void *elem);
+extern inline void *vec_push_n_uninit(Vec *v, size_t nelem);
+extern inline void vec_insert(Vec *v, void *elem, size_t pos);
+extern inline void vec_pop(Vec *v, void *elem);
+extern inline void vec_remove(Vec *v, size_t pos, void *elem);
+extern inline bool vec_is_empty(Vec *v);
+extern inline void vec_memset(Vec *v, void *dst, int val, size_t nelem);
+extern inline void vec_memcpy(Vec *v, void *dst, void *src, size_t nelem);
+extern inline void vec_memmove(Vec *v, void *dst, void *src, size_t nelem);
+extern inline int vec_memcmp(Vec *v, void *ptr1, void *ptr2, size_t nelem);
+
+// capacity of the first allocation
+#define MIN_CAP (2UL)
 
 static inline char *vec_ptr(Vec *v, size_t pos) {
     return ((char *)v->ptr) + (pos * v->szof);
 }
 
 static inline void vec_alloc(Vec *v, size_t nelem) {
-    v->ptr = malloc(nelem * v->szof);
+    v->ptr = allocator_alloc(v->alloc, nelem * v->szof, v->align);
     v->cap = nelem;
+    STATS_RECORD(v->stats, STATS_ALLOC, 0, nelem * v->szof);
 }
 
 static inline void vec_realloc(Vec *v, size_t nelem) {
-    v->ptr = realloc(v->ptr, nelem * v->szof);
+#ifdef CCOLL_STATS
+    void *old = v->ptr;
+#endif
+
+    v->ptr = allocator_realloc(
+        v->alloc,
+        v->ptr,
+        v->cap * v->szof,
+        nelem * v->szof,
+        v->align
+    );
+    STATS_RECORD(
+        v->stats,
+        STATS_REALLOC,
+        v->ptr != old ? (nelem < v->cap ? nelem : v->cap) * v->szof : 0,
+        nelem * v->szof
+    );
     v->cap = nelem;
 }
 
+static inline size_t vec_grow(Vec *v, size_t nelem) {
+    return growth_next(v->growth, v->cap * v->szof, nelem * v->szof)
+        / v->szof;
+}
+
 /**
  * @brief resize Vec.
  * 
  * if shrink, realloc by exact number
- * if grow  , realloc by GROWTH_FACTOR when possible, otherwise exact number
+ * if grow  , realloc by the Growth policy when possible, otherwise exact number
  * 
  * @param v Vec
  * @param nelem number of elements requested
  */
 static void vec_resize(Vec *v, size_t nelem) {
     if (v->cap) {
-        if (nelem < v->cap || nelem > v->cap * GROWTH_FACTOR)
+        if (nelem < v->cap)
             vec_realloc(v, nelem);
         else if (nelem > v->cap)
-            vec_realloc(v, v->cap * GROWTH_FACTOR);
+            vec_realloc(v, vec_grow(v, nelem));
     } else {
-        vec_alloc(v, nelem > GROWTH_FACTOR ? nelem : GROWTH_FACTOR);
+        vec_alloc(v, vec_grow(v, nelem > MIN_CAP ? nelem : MIN_CAP));
     }
 }
 
 void vec_new(Vec *v, size_t szof) {
+    vec_new_in(v, szof, NULL);
+}
+
+void vec_new_in(Vec *v, size_t szof, Allocator *alloc) {
+    vec_new_aligned(v, szof, 0, alloc);
+}
+
+void vec_new_aligned(Vec *v, size_t szof, size_t align, Allocator *alloc) {
+    v->ptr = NULL;
     v->cap = 0;
     v->len = 0;
     v->szof = szof;
+    v->alloc = alloc ? alloc : &allocator_std;
+    v->align = align;
+    v->growth = GROWTH_2X;
+    vec_set_stats(v, NULL);
 }
 
 void vec_new_with(Vec *v, size_t szof, size_t nelem) {
@@ -51,19 +104,21 @@ void vec_new_with(Vec *v, size_t szof, size_t nelem) {
 }
 
 void vec_new_with_zeroed(Vec *v, size_t szof, size_t nelem) {
-    vec_new_with(v, nelem, szof);
+    vec_new_with(v, szof, nelem);
     vec_memset(v, v->ptr, 0, nelem);
     v->len = nelem;
 }
 
 void vec_from(Vec *v, size_t szof, void *arr, size_t nelem) {
     vec_new(v, szof);
-    vec_insert_n(v, arr, 0, nelem);
+    vec_insert_n(v, arr, nelem, 0);
 }
 
 void vec_free(Vec *v) {
-    if (v->cap)
-        free(v->ptr);
+    if (v->cap) {
+        allocator_free(v->alloc, v->ptr, v->cap * v->szof);
+        STATS_RECORD(v->stats, STATS_FREE, 0, v->cap * v->szof);
+    }
     v->cap = 0;
     v->len = 0;
 }
@@ -96,26 +151,96 @@ void vec_insert_n(Vec *v, void *elems, size_t nelem, size_t pos) {
     if (pos <= v->len) {
         vec_reserve(v, v->len + nelem);
         vec_memmove(v, vec_ptr(v, pos + nelem), vec_ptr(v, pos), v->len - pos);
+        STATS_RECORD(
+            v->stats,
+            STATS_MOVE,
+            (v->len - pos) * v->szof,
+            v->cap * v->szof
+        );
         vec_memcpy(v, vec_ptr(v, pos), elems, nelem);
         v->len += nelem;
     }
 }
 
+void vec_extend(Vec *dst, Vec *src) {
+    size_t nelem;
+
+    nelem = src->len;
+    if (nelem) {
+        vec_reserve(dst, dst->len + nelem);
+        vec_memcpy(dst, vec_ptr(dst, dst->len), src->ptr, nelem);
+        dst->len += nelem;
+    }
+}
+
+void vec_splice(Vec *v, size_t pos, size_t nremove, void *elems, size_t ninsert) {
+    if (pos <= v->len && nremove <= v->len - pos) {
+        if (ninsert > nremove)
+            vec_reserve(v, v->len - nremove + ninsert);
+        if (ninsert != nremove) {
+            vec_memmove(
+                v,
+                vec_ptr(v, pos + ninsert),
+                vec_ptr(v, pos + nremove),
+                v->len - (pos + nremove)
+            );
+            STATS_RECORD(
+                v->stats,
+                STATS_MOVE,
+                (v->len - (pos + nremove)) * v->szof,
+                v->cap * v->szof
+            );
+        }
+        vec_memcpy(v, vec_ptr(v, pos), elems, ninsert);
+        v->len = v->len - nremove + ninsert;
+    }
+}
+
 void vec_remove_n(Vec *v, size_t pos, void *elems, size_t nelem) {
     if (pos + nelem - 1 < v->len) {
         if (elems)
             vec_memcpy(v, elems, vec_ptr(v, pos), nelem);
-        if (pos + nelem < v->len)
+        if (pos + nelem < v->len) {
             vec_memmove(
                 v,
                 vec_ptr(v, pos),
                 vec_ptr(v, pos + nelem),
                 v->len - (pos + nelem)
             );
+            STATS_RECORD(
+                v->stats,
+                STATS_MOVE,
+                (v->len - (pos + nelem)) * v->szof,
+                v->cap * v->szof
+            );
+        }
         v->len -= nelem;
     }
 }
 
+void vec_swap_remove(Vec *v, size_t pos, void *elem) {
+    if (pos < v->len) {
+        if (elem)
+            vec_memcpy(v, elem, vec_ptr(v, pos), 1);
+        v->len--;
+        if (pos != v->len)
+            vec_memcpy(v, vec_ptr(v, pos), vec_ptr(v, v->len), 1);
+    }
+}
+
+void vec_retain(Vec *v, Func_Pred pred, void *ctx) {
+    size_t i, kept;
+
+    for (i = 0, kept = 0; i < v->len; i++) {
+        if (pred(vec_ptr(v, i), ctx)) {
+            if (kept != i)
+                vec_memcpy(v, vec_ptr(v, kept), vec_ptr(v, i), 1);
+            kept++;
+        }
+    }
+    v->len = kept;
+}
+
 void vec_swap(Vec *v, size_t pos1, size_t pos2, void *tmp) {
     if (pos1 < v->len && pos2 < v->len) {
         vec_memcpy(v, tmp, vec_ptr(v, pos1), 1);
@@ -9,6 +9,20 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "allocator.h"
+#include "growth.h"
+#include "stats.h"
+
+/**
+ * @brief callback to select elements, with user context
+ */
+typedef bool (*Func_Pred)(void *elem, void *ctx);
+
+/**
+ * @brief callback to compare elements, like qsort()'s
+ */
+typedef int (*Func_Cmp)(const void *, const void *);
+
 /**
  * @brief dynamic array
  */
@@ -17,6 +31,12 @@ typedef struct Vec {
     size_t cap; /**< number of elements for which there is space allocated */
     size_t len; /**< number of usable elements */
     size_t szof; /**< sizeof() of the data type to be held */
+    Allocator *alloc; /**< where the memory comes from */
+    size_t align; /**< alignment of the memory, 0 for the default */
+    Growth growth; /**< how the capacity grows */
+#ifdef CCOLL_STATS
+    Stats *stats; /**< where the allocations are counted */
+#endif
 } Vec;
 
 /**
@@ -29,6 +49,30 @@ typedef struct Vec {
  */
 void vec_new(Vec *v, size_t szof);
 
+/**
+ * @brief new Vec whose memory comes from @p alloc
+ *
+ * the Vec is not allocated, therefore vec_data() returns NULL
+ *
+ * @param v Vec
+ * @param szof size of the single elements it's going to contain
+ * @param alloc Allocator, if NULL allocator_std
+ */
+void vec_new_in(Vec *v, size_t szof, Allocator *alloc);
+
+/**
+ * @brief new Vec whose memory is aligned to @p align
+ *
+ * e.g. 64 for vec_data() to be usable with aligned SIMD loads, or to keep elements on their own cache line.
+ * the Vec is not allocated, therefore vec_data() returns NULL
+ *
+ * @param v Vec
+ * @param szof size of the single elements it's going to contain
+ * @param align alignment, must be a power of 2 (up to the page size)
+ * @param alloc Allocator, if NULL allocator_std
+ */
+void vec_new_aligned(Vec *v, size_t szof, size_t align, Allocator *alloc);
+
 /**
  * @brief new Vec with reserved space
  *
@@ -82,6 +126,31 @@ inline void vec_truncate(Vec *v) {
     v->len = 0;
 }
 
+/**
+ * @brief change how the Vec grows
+ *
+ * @param v Vec
+ * @param growth Growth policy, GROWTH_2X by default
+ */
+inline void vec_set_growth(Vec *v, Growth growth) {
+    v->growth = growth;
+}
+
+/**
+ * @brief count the allocations of the Vec in @p stats, nothing without CCOLL_STATS
+ *
+ * @param v Vec
+ * @param stats registered Stats, NULL for stats_vec
+ */
+inline void vec_set_stats(Vec *v, Stats *stats) {
+#ifdef CCOLL_STATS
+    v->stats = stats ? stats : &stats_vec;
+#else
+    (void)v;
+    (void)stats;
+#endif
+}
+
 /**
  * @brief reserve memory ahead of time
  *
@@ -152,6 +221,30 @@ void vec_set(Vec *v, void *elem, size_t pos);
  */
 void vec_insert_n(Vec *v, void *elems, size_t nelem, size_t pos);
 
+/**
+ * @brief append all the elements of @p src at the end of @p dst through shallow-copy
+ *
+ * the Vecs must hold the same data type; @p src can be @p dst
+ *
+ * @param dst Vec
+ * @param src Vec whose elements are appended
+ */
+void vec_extend(Vec *dst, Vec *src);
+
+/**
+ * @brief replace @p nremove elements starting at pos with @p ninsert elements
+ *
+ * the elements after the replaced ones are moved only once.
+ * if the removed elements own memory, that needs to be freed before
+ *
+ * @param v Vec
+ * @param pos index of the first element replaced
+ * @param nremove number of elements to remove
+ * @param elems array of elements to insert
+ * @param ninsert number of elements of the array
+ */
+void vec_splice(Vec *v, size_t pos, size_t nremove, void *elems, size_t ninsert);
+
 /**
  * @brief insert element at the end of the vector through shallow-copy
  *
@@ -159,7 +252,30 @@ void vec_insert_n(Vec *v, void *elems, size_t nelem, size_t pos);
  * @param elem element to insert
  */
 inline void vec_push(Vec *v, void *elem) {
-    vec_insert_n(v, elem, 1, v->len);
+    if (v->len == v->cap)
+        vec_reserve(v, v->len + 1);
+    memcpy(((char *)v->ptr) + (v->len * v->szof), elem, v->szof);
+    v->len++;
+}
+
+/**
+ * @brief append @p nelem uninitialized elements at the end of the vector
+ *
+ * the caller writes them in place through the pointer returned.
+ * if changes to the Vec are made, this pointer can become invalid
+ *
+ * @param v Vec
+ * @param nelem number of elements to append
+ * @return pointer to the first new element
+ */
+inline void *vec_push_n_uninit(Vec *v, size_t nelem) {
+    void *first;
+
+    vec_reserve(v, v->len + nelem);
+    first = ((char *)v->ptr) + (v->len * v->szof);
+    v->len += nelem;
+
+    return first;
 }
 
 /**
@@ -196,7 +312,11 @@ void vec_remove_n(Vec *v, size_t pos, void *elems, size_t nelem);
  * @param elem element removed, can be NULL
  */
 inline void vec_pop(Vec *v, void *elem) {
-    vec_remove_n(v, v->len - 1, elem, 1);
+    if (v->len) {
+        v->len--;
+        if (elem)
+            memcpy(elem, ((char *)v->ptr) + (v->len * v->szof), v->szof);
+    }
 }
 
 /**
@@ -213,6 +333,96 @@ inline void vec_remove(Vec *v, size_t pos, void *elem) {
     vec_remove_n(v, pos, elem, 1);
 }
 
+/**
+ * @brief remove element from pos, replacing it with the last one
+ *
+ * O(1), but doesn't preserve the order of the elements.
+ * doesn't deallocate memory
+ * if the element owns memory, that needs to be freed through @p elem
+ *
+ * @param v Vec
+ * @param pos index of the element
+ * @param elem element removed, can be NULL
+ */
+void vec_swap_remove(Vec *v, size_t pos, void *elem);
+
+/**
+ * @brief keep only the elements for which @p pred returns true, in a single pass
+ *
+ * the order of the kept elements is preserved.
+ * doesn't deallocate memory
+ * if the elements own memory, @p pred can free it before returning false
+ *
+ * @param v Vec
+ * @param pred predicate called on every element, in order
+ * @param ctx user context passed to @p pred
+ */
+void vec_retain(Vec *v, Func_Pred pred, void *ctx);
+
+/**
+ * @brief sort the elements in place, not stable
+ *
+ * introsort: O(n log n) in the worst case, without extra memory
+ *
+ * @param v Vec
+ * @param cmp comparison function
+ */
+void vec_sort(Vec *v, Func_Cmp cmp);
+
+/**
+ * @brief sort the elements, keeping the order of the equal ones
+ *
+ * mergesort, with a temporary buffer of the Vec's size from its allocator
+ *
+ * @param v Vec
+ * @param cmp comparison function
+ */
+void vec_sort_stable(Vec *v, Func_Cmp cmp);
+
+/**
+ * @brief sort the elements by an integer key, in linear time
+ *
+ * LSD radix sort, stable, with a temporary buffer of the Vec's size from its allocator
+ *
+ * @param v Vec
+ * @param key_offset offset of the key in the element
+ * @param key_size size of the key: 1, 2, 4 or 8
+ * @param is_signed if the key is a signed integer
+ */
+void vec_radix_sort(Vec *v, size_t key_offset, size_t key_size, bool is_signed);
+
+/**
+ * @brief index of the first element not less than @p key, in a sorted Vec
+ *
+ * @param v Vec
+ * @param key key searched, the second argument of @p cmp
+ * @param cmp comparison function
+ * @return index, the length of the Vec if all the elements are less than @p key
+ */
+size_t vec_lower_bound(Vec *v, const void *key, Func_Cmp cmp);
+
+/**
+ * @brief binary search in a sorted Vec
+ *
+ * @param v Vec
+ * @param key key searched, the second argument of @p cmp
+ * @param cmp comparison function
+ * @return pointer to the first element equal to @p key, NULL if not found
+ */
+void *vec_bsearch(Vec *v, const void *key, Func_Cmp cmp);
+
+/**
+ * @brief move the elements for which @p pred returns true before the others
+ *
+ * in place, doesn't preserve the order of the elements
+ *
+ * @param v Vec
+ * @param pred predicate called on every element, in order
+ * @param ctx user context passed to @p pred
+ * @return number of elements for which @p pred returned true
+ */
+size_t vec_partition(Vec *v, Func_Pred pred, void *ctx);
+
 /**
  * @brief if Vec is empty
  *
@@ -0,0 +1,329 @@
+#define _GNU_SOURCE
+
+#include "vec_mmap.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ALIGN_UP(n, align) (((n) + (align) - 1) & ~((size_t)(align) - 1))
+
+// the threshold is stored directly in the context pointer
+#define THRESHOLD(ctx) ((size_t)(uintptr_t)(ctx))
+
+// the backing file of a Vec from vec_map_file(), owned by its allocator
+typedef struct VecFile {
+    Allocator alloc;
+    int fd;
+    bool writable;
+} VecFile;
+
+static inline size_t page_size(void) {
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+static void *map_pages(size_t size) {
+    void *ptr;
+
+    ptr = mmap(
+        NULL,
+        size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0
+    );
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+static void *mmap_cb_alloc(void *ctx, size_t size, size_t align) {
+    if (size < THRESHOLD(ctx))
+        return allocator_alloc(&allocator_std, size, align);
+    return map_pages(ALIGN_UP(size, page_size()));
+}
+
+static void *mmap_cb_realloc(
+    void *ctx,
+    void *ptr,
+    size_t old_size,
+    size_t new_size,
+    size_t align
+) {
+    size_t threshold, old_mapped, new_mapped;
+    void *next;
+
+    threshold = THRESHOLD(ctx);
+    if (old_size < threshold && new_size < threshold)
+        return allocator_realloc(&allocator_std, ptr, old_size, new_size, align);
+
+    // crossing the threshold, from malloc to pages or back
+    if (old_size < threshold) {
+        if ((next = mmap_cb_alloc(ctx, new_size, align)) != NULL) {
+            memcpy(next, ptr, old_size);
+            allocator_free(&allocator_std, ptr, old_size);
+        }
+        return next;
+    }
+    old_mapped = ALIGN_UP(old_size, page_size());
+    if (new_size < threshold) {
+        if ((next = allocator_alloc(&allocator_std, new_size, align)) != NULL) {
+            memcpy(next, ptr, new_size);
+            munmap(ptr, old_mapped);
+        }
+        return next;
+    }
+
+    new_mapped = ALIGN_UP(new_size, page_size());
+    if (new_mapped == old_mapped)
+        return ptr;
+
+    // shrinking gives the tail back to the kernel, in place
+    if (new_mapped < old_mapped) {
+        munmap(((char *)ptr) + new_mapped, old_mapped - new_mapped);
+        return ptr;
+    }
+
+#ifdef MREMAP_MAYMOVE
+    next = mremap(ptr, old_mapped, new_mapped, MREMAP_MAYMOVE);
+    return next == MAP_FAILED ? NULL : next;
+#else
+    if ((next = map_pages(new_mapped)) != NULL) {
+        memcpy(next, ptr, old_size);
+        munmap(ptr, old_mapped);
+    }
+    return next;
+#endif
+}
+
+static void mmap_cb_free(void *ctx, void *ptr, size_t size) {
+    if (size < THRESHOLD(ctx))
+        allocator_free(&allocator_std, ptr, size);
+    else
+        munmap(ptr, ALIGN_UP(size, page_size()));
+}
+
+Allocator allocator_mmap = {
+    mmap_cb_alloc,
+    mmap_cb_realloc,
+    mmap_cb_free,
+    (void *)(uintptr_t)VEC_MMAP_THRESHOLD
+};
+
+void allocator_from_mmap(Allocator *a, size_t threshold) {
+    a->alloc = mmap_cb_alloc;
+    a->realloc = mmap_cb_realloc;
+    a->free = mmap_cb_free;
+    a->ctx = (void *)(uintptr_t)threshold;
+}
+
+void vec_new_mmap(Vec *v, size_t szof) {
+    vec_new_in(v, szof, &allocator_mmap);
+    vec_set_growth(v, GROWTH_PAGE);
+}
+
+int vec_advise(Vec *v, int advice) {
+    uintptr_t start, end;
+    size_t page;
+    int ret;
+
+    if (!v->cap)
+        return 0;
+
+    page = page_size();
+    start = ALIGN_UP((uintptr_t)v->ptr, page);
+    end = ((uintptr_t)v->ptr + v->cap * v->szof) & ~(uintptr_t)(page - 1);
+    if (end <= start)
+        return 0;
+
+    ret = 0;
+    if (advice & VEC_ADVISE_SEQUENTIAL)
+        ret |= madvise((void *)start, end - start, MADV_SEQUENTIAL);
+    if (advice & VEC_ADVISE_WILLNEED)
+        ret |= madvise((void *)start, end - start, MADV_WILLNEED);
+    if (advice & VEC_ADVISE_HUGEPAGE) {
+#ifdef MADV_HUGEPAGE
+        ret |= madvise((void *)start, end - start, MADV_HUGEPAGE);
+#else
+        errno = EINVAL;
+        ret = -1;
+#endif
+    }
+
+    return ret ? -1 : 0;
+}
+
+static void *file_cb_alloc(void *ctx, size_t size, size_t align) {
+    VecFile *file;
+    void *ptr;
+
+    (void)align;
+    file = ctx;
+    if (!file->writable || ftruncate(file->fd, (off_t)size) == -1)
+        return NULL;
+
+    ptr = mmap(
+        NULL,
+        size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        file->fd,
+        0
+    );
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+static void *file_cb_realloc(
+    void *ctx,
+    void *ptr,
+    size_t old_size,
+    size_t new_size,
+    size_t align
+) {
+    VecFile *file;
+    void *next;
+
+    file = ctx;
+    if (!file->writable)
+        return NULL;
+
+    // the pages past the end of the file must not be touched.
+    // shrinking cuts the file first, so on failure the old mapping is still valid
+    if (new_size != old_size && ftruncate(file->fd, (off_t)new_size) == -1)
+        return NULL;
+
+#ifdef MREMAP_MAYMOVE
+    (void)align;
+    next = mremap(ptr, old_size, new_size, MREMAP_MAYMOVE);
+    if (next == MAP_FAILED)
+        return NULL;
+#else
+    // the content lives in the file, remapping it is enough
+    munmap(ptr, old_size);
+    if ((next = file_cb_alloc(ctx, new_size, align)) == NULL)
+        return NULL;
+#endif
+
+    return next;
+}
+
+static void file_cb_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    munmap(ptr, size);
+}
+
+int vec_map_file(Vec *v, size_t szof, const char *path, int flags) {
+    VecFile *file;
+    struct stat st;
+    int fd, oflags, err;
+
+    if (!szof) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    oflags = (flags & VEC_MAP_WRITE) ? O_RDWR : O_RDONLY;
+    if (flags & VEC_MAP_CREATE)
+        oflags |= O_CREAT;
+
+    if ((fd = open(path, oflags, 0644)) == -1)
+        return -1;
+    if (fstat(fd, &st) == -1)
+        goto fail;
+    if ((size_t)st.st_size % szof) {
+        errno = EINVAL;
+        goto fail;
+    }
+    if ((file = malloc(sizeof(*file))) == NULL)
+        goto fail;
+
+    file->alloc.alloc = file_cb_alloc;
+    file->alloc.realloc = file_cb_realloc;
+    file->alloc.free = file_cb_free;
+    file->alloc.ctx = file;
+    file->fd = fd;
+    file->writable = (flags & VEC_MAP_WRITE) != 0;
+
+    vec_new_in(v, szof, &file->alloc);
+    vec_set_growth(v, GROWTH_PAGE);
+    if (st.st_size) {
+        v->ptr = mmap(
+            NULL,
+            (size_t)st.st_size,
+            PROT_READ | (file->writable ? PROT_WRITE : 0),
+            MAP_SHARED,
+            fd,
+            0
+        );
+        if (v->ptr == MAP_FAILED) {
+            err = errno;
+            free(file);
+            vec_new(v, szof);
+            errno = err;
+            goto fail;
+        }
+        v->cap = (size_t)st.st_size / szof;
+        v->len = v->cap;
+    }
+    return 0;
+
+fail:
+    err = errno;
+    close(fd);
+    errno = err;
+    return -1;
+}
+
+int vec_sync(Vec *v) {
+    VecFile *file;
+    void *next;
+
+    // cut the file to the length, so it's consistent even if vec_unmap_file() is never reached
+    file = v->alloc->ctx;
+    if (file->writable && v->cap > v->len) {
+        if (v->len) {
+            next = file_cb_realloc(
+                file,
+                v->ptr,
+                v->cap * v->szof,
+                v->len * v->szof,
+                0
+            );
+            if (next == NULL)
+                return -1;
+            v->ptr = next;
+        } else {
+            if (ftruncate(file->fd, 0) == -1)
+                return -1;
+            munmap(v->ptr, v->cap * v->szof);
+            v->ptr = NULL;
+        }
+        v->cap = v->len;
+    }
+
+    if (!v->cap)
+        return 0;
+    return msync(v->ptr, v->cap * v->szof, MS_SYNC);
+}
+
+int vec_unmap_file(Vec *v) {
+    VecFile *file;
+    int ret;
+
+    file = v->alloc->ctx;
+    ret = 0;
+    if (v->cap)
+        munmap(v->ptr, v->cap * v->szof);
+    if (file->writable && ftruncate(file->fd, (off_t)(v->len * v->szof)) == -1)
+        ret = -1;
+    if (close(file->fd) == -1)
+        ret = -1;
+
+    vec_new(v, v->szof);
+    free(file);
+    return ret;
+}
\ No newline at end of file
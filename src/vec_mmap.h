@@ -0,0 +1,115 @@
+/**
+ * @file vec_mmap.h
+ */
+
+#ifndef __VEC_MMAP_H__
+#define __VEC_MMAP_H__
+
+#include <stdlib.h>
+
+#include "allocator.h"
+#include "vec.h"
+
+/**
+ * @brief default size from which allocator_mmap maps pages instead of using malloc
+ */
+#define VEC_MMAP_THRESHOLD (1UL << 20)
+
+/**
+ * @brief hints for vec_advise(), can be or-ed
+ */
+typedef enum VecAdvice {
+    VEC_ADVISE_SEQUENTIAL = 1 << 0, /**< the elements will be accessed in order, read ahead aggressively */
+    VEC_ADVISE_WILLNEED = 1 << 1,   /**< the elements will be accessed soon, start paging them in */
+    VEC_ADVISE_HUGEPAGE = 1 << 2,   /**< back the memory with transparent huge pages (linux only) */
+} VecAdvice;
+
+/**
+ * @brief flags for vec_map_file(), can be or-ed
+ */
+typedef enum VecMapFlags {
+    VEC_MAP_READ = 0,        /**< map the file read-only, the Vec must not be modified */
+    VEC_MAP_WRITE = 1 << 0,  /**< map the file read-write, the file grows and shrinks with the Vec */
+    VEC_MAP_CREATE = 1 << 1, /**< create the file if it doesn't exist */
+} VecMapFlags;
+
+/**
+ * @brief allocator for very big arrays, with VEC_MMAP_THRESHOLD
+ *
+ * allocations below the threshold go to malloc, the others are anonymous mappings,
+ * which grow with mremap (no copy) and shrink by unmapping their tail.
+ * alignments up to the page size are supported
+ */
+extern Allocator allocator_mmap;
+
+/**
+ * @brief allocator like allocator_mmap, with a custom threshold
+ *
+ * @param a Allocator
+ * @param threshold size from which pages are mapped
+ */
+void allocator_from_mmap(Allocator *a, size_t threshold);
+
+/**
+ * @brief new Vec backed by allocator_mmap
+ *
+ * the Vec grows with GROWTH_PAGE, so its capacity stays a multiple of the page size.
+ * the Vec is not allocated, therefore vec_data() returns NULL
+ *
+ * @param v Vec
+ * @param szof size of the single elements it's going to contain
+ */
+void vec_new_mmap(Vec *v, size_t szof);
+
+/**
+ * @brief advise the kernel on how the memory of @p v will be used
+ *
+ * applies to the pages fully inside the allocation, so it's meant for Vecs backed by allocator_mmap
+ *
+ * @param v Vec
+ * @param advice VecAdvice flags
+ * @return 0 on success, -1 on failure (errno is set)
+ */
+int vec_advise(Vec *v, int advice);
+
+/**
+ * @brief open a Vec over the records stored in the file at @p path
+ *
+ * the file is mapped shared, so its content is used in place and every change is
+ * written back to it. the Vec has one element per @p szof bytes in the file,
+ * and the file size must be a multiple of @p szof.
+ * a writable Vec extends the file with ftruncate when it grows, with GROWTH_PAGE,
+ * so the file holds zeroed records past the length until vec_sync() or vec_unmap_file() cut it.
+ * the Vec must be released with vec_unmap_file(), not vec_free()
+ *
+ * @param v Vec
+ * @param szof size of the single records, not 0
+ * @param path path of the file
+ * @param flags VecMapFlags
+ * @return 0 on success, -1 on failure (errno is set)
+ */
+int vec_map_file(Vec *v, size_t szof, const char *path, int flags);
+
+/**
+ * @brief write the changes to a Vec opened with vec_map_file() to the disk
+ *
+ * a writable file is first truncated to the length of the Vec, and the capacity shrunk to it,
+ * so the file reopens with the same records even if vec_unmap_file() is never called
+ *
+ * @param v Vec
+ * @return 0 on success, -1 on failure (errno is set)
+ */
+int vec_sync(Vec *v);
+
+/**
+ * @brief unmap a Vec opened with vec_map_file() and close its file
+ *
+ * a writable file is truncated to the length of the Vec.
+ * the Vec is left empty, as after vec_new()
+ *
+ * @param v Vec
+ * @return 0 on success, -1 on failure (errno is set)
+ */
+int vec_unmap_file(Vec *v);
+
+#endif /* __VEC_MMAP_H__ */
\ No newline at end of file
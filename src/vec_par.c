@@ -0,0 +1,253 @@
+#include "vec_par.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "thread_pool.h"
+
+#define AT(base, i, szof) (((char *)(base)) + ((i) * (szof)))
+
+#define ALIGN_UP(n, align) (((n) + (align) - 1) & ~((size_t)(align) - 1))
+
+// the partial results of the tasks are a cache line apart, so the folds don't share lines
+#define CACHE_LINE (64)
+
+// elements [task * grain, (task + 1) * grain) of the Vec
+typedef struct Chunks {
+    Vec *v;
+    size_t grain;
+} Chunks;
+
+static inline size_t chunks_count(Vec *v, size_t grain) {
+    return (v->len + grain - 1) / grain;
+}
+
+static inline size_t chunk_len(Chunks *chunks, size_t task) {
+    size_t start;
+
+    start = task * chunks->grain;
+    return chunks->v->len - start < chunks->grain ? chunks->v->len - start : chunks->grain;
+}
+
+/********************************************************************************************
+ *                                        FOR EACH                                          *
+ ********************************************************************************************/
+
+typedef struct ForEach {
+    Chunks chunks;
+    Func_Each func;
+    void *ctx;
+} ForEach;
+
+static void for_each_task(void *arg, size_t task) {
+    ForEach *job;
+    char *elem;
+    size_t i, n;
+
+    job = arg;
+    n = chunk_len(&job->chunks, task);
+    elem = AT(job->chunks.v->ptr, task * job->chunks.grain, job->chunks.v->szof);
+    for (i = 0; i < n; i++, elem += job->chunks.v->szof)
+        job->func(elem, job->ctx);
+}
+
+void vec_par_for_each(Vec *v, size_t grain, Func_Each func, void *ctx) {
+    ForEach job;
+
+    job.chunks.v = v;
+    job.chunks.grain = grain ? grain : VEC_PAR_GRAIN;
+    job.func = func;
+    job.ctx = ctx;
+
+    if (v->len <= job.chunks.grain) {
+        if (v->len)
+            for_each_task(&job, 0);
+        return;
+    }
+    threadpool_run(
+        threadpool_default(),
+        for_each_task,
+        &job,
+        chunks_count(v, job.chunks.grain)
+    );
+}
+
+/********************************************************************************************
+ *                                         REDUCE                                           *
+ ********************************************************************************************/
+
+typedef struct Reduce {
+    Chunks chunks;
+    char *accs;
+    size_t acc_szof;
+    size_t stride; // distance between the partial results
+    Func_Fold fold;
+    void *ctx;
+} Reduce;
+
+static void reduce_task(void *arg, size_t task) {
+    Reduce *job;
+    char *elem, *acc;
+    size_t i, n;
+
+    job = arg;
+    n = chunk_len(&job->chunks, task);
+    elem = AT(job->chunks.v->ptr, task * job->chunks.grain, job->chunks.v->szof);
+    acc = AT(job->accs, task, job->stride);
+    for (i = 0; i < n; i++, elem += job->chunks.v->szof)
+        job->fold(acc, elem, job->ctx);
+}
+
+void vec_par_reduce(
+    Vec *v,
+    size_t grain,
+    void *acc,
+    size_t acc_szof,
+    Func_Fold fold,
+    Func_Fold combine,
+    void *ctx
+) {
+    Reduce job;
+    size_t i, ntasks, bytes;
+
+    job.chunks.v = v;
+    job.chunks.grain = grain ? grain : VEC_PAR_GRAIN;
+    job.acc_szof = acc_szof;
+    job.stride = ALIGN_UP(acc_szof ? acc_szof : 1, CACHE_LINE);
+    job.fold = fold;
+    job.ctx = ctx;
+
+    ntasks = chunks_count(v, job.chunks.grain);
+    bytes = ntasks * job.stride;
+    job.accs = v->len > job.chunks.grain
+        ? allocator_alloc(v->alloc, bytes, CACHE_LINE)
+        : NULL;
+    if (!job.accs) {
+        // folding straight into acc on this thread, no partial results
+        job.chunks.grain = v->len;
+        job.accs = acc;
+        if (v->len)
+            reduce_task(&job, 0);
+        return;
+    }
+
+    for (i = 0; i < ntasks; i++)
+        memcpy(AT(job.accs, i, job.stride), acc, acc_szof);
+
+    threadpool_run(threadpool_default(), reduce_task, &job, ntasks);
+
+    for (i = 0; i < ntasks; i++)
+        combine(acc, AT(job.accs, i, job.stride), ctx);
+    allocator_free(v->alloc, job.accs, bytes);
+}
+
+/********************************************************************************************
+ *                                          SORT                                            *
+ ********************************************************************************************/
+
+typedef struct Sort {
+    Vec *v;
+    size_t nparts;
+    size_t width; // parts already merged together, in the current round
+    char *src;
+    char *dst;
+    Func_Cmp cmp;
+} Sort;
+
+// first element of part @p part, the parts have the same size give or take one
+static inline size_t part_start(Sort *job, size_t part) {
+    if (part >= job->nparts)
+        return job->v->len;
+    return part * job->v->len / job->nparts;
+}
+
+static void sort_task(void *arg, size_t task) {
+    Sort *job;
+    Vec part;
+    size_t start;
+
+    job = arg;
+    start = part_start(job, task);
+    part = *job->v;
+    part.ptr = AT(job->v->ptr, start, job->v->szof);
+    part.len = part_start(job, task + 1) - start;
+    part.cap = part.len;
+    vec_sort(&part, job->cmp);
+}
+
+static void merge_task(void *arg, size_t task) {
+    Sort *job;
+    char *dst, *left, *right, *left_end, *right_end;
+    size_t szof, start, mid, end;
+
+    job = arg;
+    szof = job->v->szof;
+    start = part_start(job, task * 2 * job->width);
+    mid = part_start(job, task * 2 * job->width + job->width);
+    end = part_start(job, (task + 1) * 2 * job->width);
+
+    dst = AT(job->dst, start, szof);
+    left = AT(job->src, start, szof);
+    left_end = right = AT(job->src, mid, szof);
+    right_end = AT(job->src, end, szof);
+    while (left < left_end && right < right_end) {
+        if (job->cmp(left, right) <= 0) {
+            memcpy(dst, left, szof);
+            left += szof;
+        } else {
+            memcpy(dst, right, szof);
+            right += szof;
+        }
+        dst += szof;
+    }
+    memcpy(dst, left, (size_t)(left_end - left));
+    dst += left_end - left;
+    memcpy(dst, right, (size_t)(right_end - right));
+}
+
+void vec_par_sort(Vec *v, size_t grain, Func_Cmp cmp) {
+    ThreadPool *pool;
+    Sort job;
+    char *buf, *tmp;
+    size_t bytes;
+
+    if (!grain)
+        grain = VEC_PAR_GRAIN;
+    if (v->len <= grain) {
+        vec_sort(v, cmp);
+        return;
+    }
+
+    // a part per thread, unless that makes them smaller than grain
+    pool = threadpool_default();
+    job.v = v;
+    job.nparts = chunks_count(v, grain);
+    if (job.nparts > pool->nthreads + 1)
+        job.nparts = pool->nthreads + 1;
+    job.cmp = cmp;
+    bytes = v->len * v->szof;
+    if (job.nparts < 2
+        || (buf = allocator_alloc(v->alloc, bytes, v->align)) == NULL) {
+        vec_sort(v, cmp);
+        return;
+    }
+    threadpool_run(pool, sort_task, &job, job.nparts);
+
+    // rounds of pairwise merges between the Vec and a buffer
+    job.src = v->ptr;
+    job.dst = buf;
+    for (job.width = 1; job.width < job.nparts; job.width *= 2) {
+        threadpool_run(
+            pool,
+            merge_task,
+            &job,
+            (job.nparts + 2 * job.width - 1) / (2 * job.width)
+        );
+        tmp = job.src;
+        job.src = job.dst;
+        job.dst = tmp;
+    }
+    if (job.src != v->ptr)
+        memcpy(v->ptr, job.src, bytes);
+    allocator_free(v->alloc, buf, bytes);
+}
\ No newline at end of file
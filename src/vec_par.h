@@ -0,0 +1,80 @@
+/**
+ * @file vec_par.h
+ */
+
+#ifndef __VEC_PAR_H__
+#define __VEC_PAR_H__
+
+#include <stdlib.h>
+
+#include "thread_pool.h"
+#include "vec.h"
+
+/**
+ * @brief number of elements per task when the grain passed is 0
+ */
+#define VEC_PAR_GRAIN (1UL << 14)
+
+/**
+ * @brief callback called on one element, with user context
+ */
+typedef void (*Func_Each)(void *elem, void *ctx);
+
+/**
+ * @brief callback folding @p x into the accumulator @p acc, with user context
+ */
+typedef void (*Func_Fold)(void *acc, void *x, void *ctx);
+
+/**
+ * @brief call @p func on every element, in parallel on threadpool_default()
+ *
+ * the elements are split in tasks of @p grain elements;
+ * a Vec that fits in one task is processed on the calling thread
+ *
+ * @param v Vec
+ * @param grain number of elements per task, 0 for VEC_PAR_GRAIN
+ * @param func callback, called concurrently on different elements
+ * @param ctx user context passed to @p func
+ */
+void vec_par_for_each(Vec *v, size_t grain, Func_Each func, void *ctx);
+
+/**
+ * @brief fold all the elements into @p acc, in parallel on threadpool_default()
+ *
+ * every task folds its elements with @p fold into a copy of the initial @p acc,
+ * then the partial results are folded into @p acc with @p combine, in order.
+ * so the initial @p acc must be the identity of @p combine (0 for a sum, 1 for a product).
+ * the partial results come from the Vec's allocator, a cache line each;
+ * if they can't be allocated, everything is folded on the calling thread
+ *
+ * @param v Vec
+ * @param grain number of elements per task, 0 for VEC_PAR_GRAIN
+ * @param acc accumulator, initial value and result
+ * @param acc_szof size of the accumulator
+ * @param fold callback folding an element into an accumulator, called concurrently
+ * @param combine callback folding a partial result into an accumulator
+ * @param ctx user context passed to @p fold and @p combine
+ */
+void vec_par_reduce(
+    Vec *v,
+    size_t grain,
+    void *acc,
+    size_t acc_szof,
+    Func_Fold fold,
+    Func_Fold combine,
+    void *ctx
+);
+
+/**
+ * @brief sort the elements in parallel on threadpool_default(), not stable
+ *
+ * parts of at least @p grain elements are sorted with vec_sort(), then merged pairwise.
+ * uses a temporary buffer of the Vec's size from its allocator
+ *
+ * @param v Vec
+ * @param grain minimum number of elements per part, 0 for VEC_PAR_GRAIN
+ * @param cmp comparison function
+ */
+void vec_par_sort(Vec *v, size_t grain, Func_Cmp cmp);
+
+#endif /* __VEC_PAR_H__ */
\ No newline at end of file
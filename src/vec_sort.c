@@ -0,0 +1,357 @@
+#include "vec.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// partitions this small are insertion sorted
+#define INSERTION_MAX (16)
+
+// elements are swapped through the stack this many bytes at a time
+#define SWAP_CHUNK (64)
+
+#define AT(base, i, szof) ((base) + ((i) * (szof)))
+
+// word sized elements are swapped in registers
+#define SWAP_AS(T, a, b) \
+    do { \
+        T tmp_; \
+        memcpy(&tmp_, a, sizeof(T)); \
+        memcpy(a, b, sizeof(T)); \
+        memcpy(b, &tmp_, sizeof(T)); \
+    } while (0)
+
+static inline void elem_swap(char *a, char *b, size_t szof) {
+    unsigned char tmp[SWAP_CHUNK];
+    size_t n;
+
+    if (szof == sizeof(uint64_t)) {
+        SWAP_AS(uint64_t, a, b);
+        return;
+    }
+    if (szof == sizeof(uint32_t)) {
+        SWAP_AS(uint32_t, a, b);
+        return;
+    }
+
+    while (szof) {
+        n = szof < SWAP_CHUNK ? szof : SWAP_CHUNK;
+        memcpy(tmp, a, n);
+        memcpy(a, b, n);
+        memcpy(b, tmp, n);
+        a += n;
+        b += n;
+        szof -= n;
+    }
+}
+
+static inline void elem_copy(char *dst, const char *src, size_t szof) {
+    if (szof == sizeof(uint64_t))
+        memcpy(dst, src, sizeof(uint64_t));
+    else if (szof == sizeof(uint32_t))
+        memcpy(dst, src, sizeof(uint32_t));
+    else
+        memcpy(dst, src, szof);
+}
+
+// stable, only swaps strictly greater neighbours
+static void insertion_sort(char *base, size_t n, size_t szof, Func_Cmp cmp) {
+    size_t i, j;
+
+    for (i = 1; i < n; i++)
+        for (j = i; j && cmp(AT(base, j - 1, szof), AT(base, j, szof)) > 0; j--)
+            elem_swap(AT(base, j - 1, szof), AT(base, j, szof), szof);
+}
+
+/********************************************************************************************
+ *                                        INTROSORT                                         *
+ ********************************************************************************************/
+
+static void sift_down(char *base, size_t root, size_t n, size_t szof, Func_Cmp cmp) {
+    size_t child;
+
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n
+            && cmp(AT(base, child, szof), AT(base, child + 1, szof)) < 0)
+            child++;
+        if (cmp(AT(base, root, szof), AT(base, child, szof)) >= 0)
+            return;
+        elem_swap(AT(base, root, szof), AT(base, child, szof), szof);
+        root = child;
+    }
+}
+
+static void heap_sort(char *base, size_t n, size_t szof, Func_Cmp cmp) {
+    size_t i;
+
+    for (i = n / 2; i--;)
+        sift_down(base, i, n, szof, cmp);
+    for (i = n - 1; i; i--) {
+        elem_swap(base, AT(base, i, szof), szof);
+        sift_down(base, 0, i, szof, cmp);
+    }
+}
+
+// moves the median of the first, middle and last element to the front
+static void median_to_front(char *base, size_t n, size_t szof, Func_Cmp cmp) {
+    char *a, *b, *c, *median;
+
+    a = base;
+    b = AT(base, n / 2, szof);
+    c = AT(base, n - 1, szof);
+    if (cmp(a, b) < 0)
+        median = cmp(b, c) < 0 ? b : (cmp(a, c) < 0 ? c : a);
+    else
+        median = cmp(a, c) < 0 ? a : (cmp(b, c) < 0 ? c : b);
+    if (median != base)
+        elem_swap(base, median, szof);
+}
+
+// quicksort, turning into heapsort when the recursion gets too deep
+static void
+introsort(char *base, size_t n, size_t szof, Func_Cmp cmp, unsigned depth) {
+    size_t i, j;
+
+    while (n > INSERTION_MAX) {
+        if (!depth--) {
+            heap_sort(base, n, szof, cmp);
+            return;
+        }
+
+        // hoare partition around base[0], elements equal to the pivot go both ways
+        median_to_front(base, n, szof, cmp);
+        i = 1;
+        j = n - 1;
+        for (;;) {
+            while (i <= j && cmp(AT(base, i, szof), base) < 0)
+                i++;
+            while (j >= i && cmp(AT(base, j, szof), base) > 0)
+                j--;
+            if (i >= j)
+                break;
+            elem_swap(AT(base, i, szof), AT(base, j, szof), szof);
+            i++;
+            j--;
+        }
+        if (j)
+            elem_swap(base, AT(base, j, szof), szof);
+
+        // recurse on the smaller side, so the stack stays O(log n)
+        if (j < n - j - 1) {
+            introsort(base, j, szof, cmp, depth);
+            base = AT(base, j + 1, szof);
+            n -= j + 1;
+        } else {
+            introsort(AT(base, j + 1, szof), n - j - 1, szof, cmp, depth);
+            n = j;
+        }
+    }
+    insertion_sort(base, n, szof, cmp);
+}
+
+void vec_sort(Vec *v, Func_Cmp cmp) {
+    unsigned depth;
+    size_t n;
+
+    for (depth = 0, n = v->len; n > 1; n >>= 1)
+        depth += 2;
+    if (v->len > 1)
+        introsort(v->ptr, v->len, v->szof, cmp, depth);
+}
+
+/********************************************************************************************
+ *                                        MERGESORT                                         *
+ ********************************************************************************************/
+
+static void merge(
+    char *dst,
+    char *left,
+    size_t nleft,
+    char *right,
+    size_t nright,
+    size_t szof,
+    Func_Cmp cmp
+) {
+    // ties take from the left, to keep the sort stable
+    while (nleft && nright) {
+        if (cmp(left, right) <= 0) {
+            elem_copy(dst, left, szof);
+            left += szof;
+            nleft--;
+        } else {
+            elem_copy(dst, right, szof);
+            right += szof;
+            nright--;
+        }
+        dst += szof;
+    }
+    memcpy(dst, left, nleft * szof);
+    memcpy(dst + nleft * szof, right, nright * szof);
+}
+
+void vec_sort_stable(Vec *v, Func_Cmp cmp) {
+    char *src, *dst, *tmp, *buf;
+    size_t i, n, run, szof;
+
+    n = v->len;
+    szof = v->szof;
+    if (n <= INSERTION_MAX) {
+        insertion_sort(v->ptr, n, szof, cmp);
+        return;
+    }
+
+    // bottom-up: sorted runs, then merge passes between the Vec and a buffer
+    for (i = 0; i < n; i += INSERTION_MAX)
+        insertion_sort(
+            AT((char *)v->ptr, i, szof),
+            n - i < INSERTION_MAX ? n - i : INSERTION_MAX,
+            szof,
+            cmp
+        );
+
+    buf = allocator_alloc(v->alloc, n * szof, v->align);
+    src = v->ptr;
+    dst = buf;
+    for (run = INSERTION_MAX; run < n; run *= 2) {
+        for (i = 0; i < n; i += 2 * run) {
+            size_t nleft, nright;
+
+            nleft = n - i < run ? n - i : run;
+            nright = n - i - nleft < run ? n - i - nleft : run;
+            merge(
+                AT(dst, i, szof),
+                AT(src, i, szof),
+                nleft,
+                AT(src, i + nleft, szof),
+                nright,
+                szof,
+                cmp
+            );
+        }
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    if (src != v->ptr)
+        memcpy(v->ptr, src, n * szof);
+    allocator_free(v->alloc, buf, n * szof);
+}
+
+/********************************************************************************************
+ *                                        RADIX SORT                                        *
+ ********************************************************************************************/
+
+// key as an unsigned integer, which sorts like the original
+static inline uint64_t
+radix_key(const char *elem, size_t key_size, bool is_signed) {
+    uint64_t key;
+
+    switch (key_size) {
+    case 1: { uint8_t k; memcpy(&k, elem, 1); key = k; break; }
+    case 2: { uint16_t k; memcpy(&k, elem, 2); key = k; break; }
+    case 4: { uint32_t k; memcpy(&k, elem, 4); key = k; break; }
+    default: { uint64_t k; memcpy(&k, elem, 8); key = k; break; }
+    }
+    // flipping the sign bit puts negative numbers first
+    if (is_signed)
+        key ^= (uint64_t)1 << (key_size * 8 - 1);
+    return key;
+}
+
+void vec_radix_sort(Vec *v, size_t key_offset, size_t key_size, bool is_signed) {
+    size_t counts[8][256] = {{0}};
+    char *src, *dst, *tmp, *buf;
+    size_t i, n, pass, szof, sum, next;
+    unsigned byte;
+
+    n = v->len;
+    szof = v->szof;
+    if (n < 2)
+        return;
+
+    // one pass to count the digits of every byte
+    for (i = 0; i < n; i++) {
+        uint64_t key;
+
+        key = radix_key(AT((char *)v->ptr, i, szof) + key_offset, key_size, is_signed);
+        for (pass = 0; pass < key_size; pass++)
+            counts[pass][(key >> (pass * 8)) & 0xFF]++;
+    }
+
+    buf = allocator_alloc(v->alloc, n * szof, v->align);
+    src = v->ptr;
+    dst = buf;
+    for (pass = 0; pass < key_size; pass++) {
+        // every key has the same digit, nothing to do
+        byte = (radix_key(src + key_offset, key_size, is_signed) >> (pass * 8)) & 0xFF;
+        if (counts[pass][byte] == n)
+            continue;
+
+        for (i = 0, sum = 0; i < 256; i++) {
+            next = sum + counts[pass][i];
+            counts[pass][i] = sum;
+            sum = next;
+        }
+        for (i = 0; i < n; i++) {
+            char *elem;
+
+            elem = AT(src, i, szof);
+            byte = (radix_key(elem + key_offset, key_size, is_signed) >> (pass * 8)) & 0xFF;
+            elem_copy(AT(dst, counts[pass][byte]++, szof), elem, szof);
+        }
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    if (src != v->ptr)
+        memcpy(v->ptr, src, n * szof);
+    allocator_free(v->alloc, buf, n * szof);
+}
+
+/********************************************************************************************
+ *                                        SEARCHING                                         *
+ ********************************************************************************************/
+
+size_t vec_lower_bound(Vec *v, const void *key, Func_Cmp cmp) {
+    size_t lo, hi, mid;
+
+    lo = 0;
+    hi = v->len;
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (cmp(AT((char *)v->ptr, mid, v->szof), key) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+void *vec_bsearch(Vec *v, const void *key, Func_Cmp cmp) {
+    size_t pos;
+    char *elem;
+
+    pos = vec_lower_bound(v, key, cmp);
+    if (pos == v->len)
+        return NULL;
+    elem = AT((char *)v->ptr, pos, v->szof);
+    return cmp(elem, key) == 0 ? elem : NULL;
+}
+
+size_t vec_partition(Vec *v, Func_Pred pred, void *ctx) {
+    size_t i, kept;
+
+    for (i = 0, kept = 0; i < v->len; i++) {
+        if (pred(AT((char *)v->ptr, i, v->szof), ctx)) {
+            if (kept != i)
+                elem_swap(
+                    AT((char *)v->ptr, kept, v->szof),
+                    AT((char *)v->ptr, i, v->szof),
+                    v->szof
+                );
+            kept++;
+        }
+    }
+    return kept;
+}
\ No newline at end of file
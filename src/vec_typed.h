@@ -0,0 +1,132 @@
+/**
+ * @file vec_typed.h
+ */
+
+#ifndef __VEC_TYPED_H__
+#define __VEC_TYPED_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vec.h"
+
+/**
+ * @brief define a Vec specialized for @p T, named @p name
+ *
+ * generates the type @p name and static inline functions `name_new`, `name_push`, `name_at` etc.
+ * the element size is known at compile time, so accesses are plain loads and stores.
+ * growth, allocation and everything not generated goes through the generic Vec, reachable with `name_vec()`.
+ * `name_get`, `name_set` and `name_pop` don't check bounds, `name_at` returns NULL when out of bounds.
+ * `name_remove` out of bounds removes nothing and returns a zeroed @p T.
+ *
+ * e.g. `VEC_DEFINE(IntVec, int)` then `IntVec v; IntVec_new(&v); IntVec_push(&v, 42);`
+ *
+ * @param name name of the type, prefix of the functions
+ * @param T type of the elements
+ */
+#define VEC_DEFINE(name, T) \
+    typedef struct name { \
+        Vec vec; /**< generic Vec, with szof == sizeof(T) */ \
+    } name; \
+\
+    static inline void name##_new(name *v) { \
+        vec_new(&v->vec, sizeof(T)); \
+    } \
+\
+    static inline void name##_new_in(name *v, Allocator *alloc) { \
+        vec_new_in(&v->vec, sizeof(T), alloc); \
+    } \
+\
+    static inline void name##_new_with(name *v, size_t nelem) { \
+        vec_new_with(&v->vec, sizeof(T), nelem); \
+    } \
+\
+    static inline void name##_free(name *v) { \
+        vec_free(&v->vec); \
+    } \
+\
+    static inline Vec *name##_vec(name *v) { \
+        return &v->vec; \
+    } \
+\
+    static inline T *name##_data(name *v) { \
+        return (T *)v->vec.ptr; \
+    } \
+\
+    static inline size_t name##_len(name *v) { \
+        return v->vec.len; \
+    } \
+\
+    static inline bool name##_is_empty(name *v) { \
+        return v->vec.len == 0; \
+    } \
+\
+    static inline void name##_truncate(name *v) { \
+        v->vec.len = 0; \
+    } \
+\
+    static inline void name##_reserve(name *v, size_t nelem) { \
+        vec_reserve(&v->vec, nelem); \
+    } \
+\
+    static inline T *name##_at(name *v, size_t pos) { \
+        if (pos < v->vec.len) \
+            return (T *)v->vec.ptr + pos; \
+        return NULL; \
+    } \
+\
+    static inline T name##_get(name *v, size_t pos) { \
+        return ((T *)v->vec.ptr)[pos]; \
+    } \
+\
+    static inline void name##_set(name *v, size_t pos, T elem) { \
+        ((T *)v->vec.ptr)[pos] = elem; \
+    } \
+\
+    static inline void name##_push(name *v, T elem) { \
+        if (v->vec.len == v->vec.cap) \
+            vec_reserve(&v->vec, v->vec.len + 1); \
+        ((T *)v->vec.ptr)[v->vec.len++] = elem; \
+    } \
+\
+    static inline T name##_pop(name *v) { \
+        return ((T *)v->vec.ptr)[--v->vec.len]; \
+    } \
+\
+    static inline void name##_insert(name *v, size_t pos, T elem) { \
+        vec_insert_n(&v->vec, &elem, 1, pos); \
+    } \
+\
+    static inline T name##_remove(name *v, size_t pos) { \
+        T elem; \
+\
+        memset(&elem, 0, sizeof(elem)); \
+        vec_remove_n(&v->vec, pos, &elem, 1); \
+        return elem; \
+    } \
+\
+    static inline void name##_sort(name *v, Func_Cmp cmp) { \
+        vec_sort(&v->vec, cmp); \
+    } \
+\
+    static inline void name##_sort_stable(name *v, Func_Cmp cmp) { \
+        vec_sort_stable(&v->vec, cmp); \
+    }
+
+/**
+ * @brief like VEC_DEFINE(), for an integer type @p T
+ *
+ * also generates `name_radix_sort`, which sorts the elements by value in linear time
+ *
+ * @param name name of the type, prefix of the functions
+ * @param T integer type of the elements, up to 64 bits
+ */
+#define VEC_DEFINE_INT(name, T) \
+    VEC_DEFINE(name, T) \
+\
+    static inline void name##_radix_sort(name *v) { \
+        vec_radix_sort(&v->vec, 0, sizeof(T), (T)-1 < (T)0); \
+    }
+
+#endif /* __VEC_TYPED_H__ */
\ No newline at end of file
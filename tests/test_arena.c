@@ -0,0 +1,52 @@
+// Arena checks, run by make test
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "arena.h"
+
+// an allocation made before a mark must not grow in place over the memory the rewind releases
+static void test_mark_grow_rewind(void) {
+    Arena arena;
+    ArenaMark mark;
+    char *a, *grown, *scratch;
+    int i, rep;
+
+    arena_init(&arena);
+    a = arena_alloc(&arena, 16);
+    memset(a, 'a', 16);
+    // the same mark rewound to several times, as in a loop
+    mark = arena_mark(&arena);
+    for (rep = 0; rep < 3; rep++) {
+        grown = arena_realloc(&arena, 64, a);
+        assert(grown != a);
+        for (i = 0; i < 16; i++)
+            assert(grown[i] == 'a');
+        arena_rewind(&arena, mark);
+        scratch = arena_alloc(&arena, 64);
+        memset(scratch, 's', 64);
+        for (i = 0; i < 16; i++)
+            assert(a[i] == 'a');
+        arena_rewind(&arena, mark);
+    }
+    arena_free(&arena);
+}
+
+// without marks the last allocation still grows in place
+static void test_grow_in_place(void) {
+    Arena arena;
+    char *a;
+
+    arena_init(&arena);
+    a = arena_alloc(&arena, 16);
+    assert(arena_realloc(&arena, 64, a) == a);
+    arena_free(&arena);
+}
+
+int main(void) {
+    test_mark_grow_rewind();
+    test_grow_in_place();
+    puts("test_arena ok");
+    return 0;
+}
\ No newline at end of file
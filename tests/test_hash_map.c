@@ -0,0 +1,53 @@
+// HashMap checks, run by make test
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hash_map.h"
+
+static void test_entry(void) {
+    bool inserted;
+    HashMap m;
+    int key, *val, *stored;
+
+    hashmap_new(&m, sizeof(int), sizeof(int));
+    for (key = 0; key < 1000; key++) {
+        val = hashmap_entry(&m, &key, &inserted, (void **)&stored);
+        assert(inserted && *val == 0 && *stored == key);
+        *val = key * 2;
+    }
+    for (key = 0; key < 1000; key++) {
+        val = hashmap_entry(&m, &key, &inserted, NULL);
+        assert(!inserted && *val == key * 2);
+    }
+    assert(hashmap_len(&m) == 1000);
+
+    // put without a value zeroes an existing one
+    key = 5;
+    hashmap_put(&m, &key, NULL);
+    assert(*(int *)hashmap_get(&m, &key) == 0);
+    hashmap_free(&m);
+}
+
+static void test_entry_str(void) {
+    bool inserted;
+    HashMap m;
+    int *val;
+
+    hashmap_new_sstr(&m, sizeof(int), NULL);
+    val = hashmap_entry_str(&m, sstrview_from("key"), &inserted);
+    assert(inserted && *val == 0);
+    *val = 42;
+    val = hashmap_entry_str(&m, sstrview_from("key"), &inserted);
+    assert(!inserted && *val == 42);
+    assert(*(int *)hashmap_get_str(&m, sstrview_from("key")) == 42);
+    hashmap_free(&m);
+}
+
+int main(void) {
+    test_entry();
+    test_entry_str();
+    puts("test_hash_map ok");
+    return 0;
+}
\ No newline at end of file
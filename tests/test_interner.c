@@ -0,0 +1,34 @@
+// Interner checks, run by make test
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "interner.h"
+
+// the interned copy must not point to the caller's buffer
+static void test_intern_copies(void) {
+    Interner in;
+    InternId a, b, found;
+    char buf[16];
+
+    interner_init(&in);
+    strcpy(buf, "alpha");
+    a = interner_intern(&in, sstrview_from(buf));
+    strcpy(buf, "beta!");
+    b = interner_intern(&in, sstrview_from(buf));
+    assert(a != b);
+    assert(strcmp(interner_str(&in, a), "alpha") == 0);
+    assert(strcmp(interner_str(&in, b), "beta!") == 0);
+    assert(interner_intern(&in, sstrview_from("alpha")) == a);
+    assert(interner_find(&in, sstrview_from("beta!"), &found) && found == b);
+    assert(!interner_find(&in, sstrview_from("gamma"), NULL));
+    assert(interner_len(&in) == 2);
+    interner_free(&in);
+}
+
+int main(void) {
+    test_intern_copies();
+    puts("test_interner ok");
+    return 0;
+}
\ No newline at end of file
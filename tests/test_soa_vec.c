@@ -0,0 +1,29 @@
+// SoaVec checks, run by make test
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "soa_vec.h"
+
+static void test_too_many_cols(void) {
+    size_t szofs[SOAVEC_MAX_COLS + 1];
+    size_t col;
+    SoaVec v;
+
+    for (col = 0; col < SOAVEC_MAX_COLS + 1; col++)
+        szofs[col] = sizeof(int);
+    assert(soavec_new(&v, szofs, SOAVEC_MAX_COLS + 1) == -1);
+    assert(v.ncols == 0);
+    assert(soavec_column(&v, SOAVEC_MAX_COLS) == NULL);
+    soavec_free(&v);
+
+    assert(soavec_new(&v, szofs, SOAVEC_MAX_COLS) == 0);
+    assert(v.ncols == SOAVEC_MAX_COLS);
+    soavec_free(&v);
+}
+
+int main(void) {
+    test_too_many_cols();
+    puts("test_soa_vec ok");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+// SStr checks, run by make test
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sstr.h"
+
+static void test_free_inline(void) {
+    SStr s;
+
+    sstr_from(&s, "abc");
+    sstr_set_growth(&s, GROWTH_1_5X);
+    assert(!sstr_is_heap(&s));
+    sstr_free(&s);
+    assert(sstr_len(&s) == 0);
+    assert(strcmp(sstr_data(&s), "") == 0);
+
+    // the growth policy survives, and the SStr can be reused
+    sstr_cat(&s, "reused");
+    assert(strcmp(sstr_data(&s), "reused") == 0);
+    sstr_free(&s);
+}
+
+static void test_free_heap(void) {
+    SStr s;
+
+    sstr_from(&s, "a string too long to be stored inline");
+    assert(sstr_is_heap(&s));
+    sstr_free(&s);
+    assert(!sstr_is_heap(&s));
+    assert(sstr_len(&s) == 0);
+    assert(strcmp(sstr_data(&s), "") == 0);
+}
+
+static void test_merge_consumes_inline(void) {
+    SStr a, b;
+
+    sstr_from(&a, "wx");
+    sstr_from(&b, "yz");
+    sstr_merge(&a, &b, ",");
+    assert(strcmp(sstr_data(&a), "wx,yz") == 0);
+    assert(sstr_len(&b) == 0);
+    assert(strcmp(sstr_data(&b), "") == 0);
+    sstr_free(&a);
+}
+
+static void test_find_tails(void) {
+    char buf[100];
+    size_t len;
+
+    // the SIMD kernels hand their tails, shorter than the needle at the end, to the scalar search
+    memset(buf, 'a', sizeof(buf));
+    for (len = 0; len <= sizeof(buf); len++) {
+        assert(sstrview_find(sstrview_from_n(buf, len), sstrview_from("aab")) == SSTR_NPOS);
+        if (len >= 3) {
+            buf[len - 1] = 'b';
+            assert(sstrview_find(sstrview_from_n(buf, len), sstrview_from("aab")) == len - 3);
+            buf[len - 1] = 'a';
+        }
+    }
+}
+
+static void test_catv(void) {
+    const char *sources[100];
+    char expected[300];
+    size_t i, n;
+    SStr s;
+
+    // both sides of the lengths kept on the stack
+    for (i = 0; i < 100; i++)
+        sources[i] = i % 2 ? "b" : "";
+    for (n = 0; n <= 100; n += 25) {
+        sstr_from(&s, ">");
+        sstr_catv(&s, sources, n, ",");
+        strcpy(expected, ">");
+        for (i = 0; i < n; i++) {
+            if (i)
+                strcat(expected, ",");
+            strcat(expected, sources[i]);
+        }
+        assert(strcmp(sstr_data(&s), expected) == 0);
+        assert(sstr_len(&s) == strlen(expected));
+        sstr_free(&s);
+    }
+}
+
+int main(void) {
+    test_free_inline();
+    test_free_heap();
+    test_merge_consumes_inline();
+    test_find_tails();
+    test_catv();
+    puts("test_sstr ok");
+    return 0;
+}
\ No newline at end of file
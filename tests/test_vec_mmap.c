@@ -0,0 +1,63 @@
+// file-backed Vec checks, run by make test
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vec_mmap.h"
+
+#define PATH "/tmp/ccoll_test_vec_mmap.bin"
+
+static size_t file_size(void) {
+    struct stat st;
+
+    assert(stat(PATH, &st) == 0);
+    return (size_t)st.st_size;
+}
+
+// a file synced but never unmapped reopens with only the records pushed
+static void test_sync_cuts_file(void) {
+    Vec v, w;
+    int i;
+
+    unlink(PATH);
+    assert(vec_map_file(&v, sizeof(int), PATH, VEC_MAP_WRITE | VEC_MAP_CREATE) == 0);
+    for (i = 0; i < 3; i++)
+        vec_push(&v, &i);
+    assert(vec_sync(&v) == 0);
+    assert(file_size() == 3 * sizeof(int));
+
+    assert(vec_map_file(&w, sizeof(int), PATH, VEC_MAP_READ) == 0);
+    assert(w.len == 3);
+    for (i = 0; i < 3; i++)
+        assert(((int *)vec_data(&w))[i] == i);
+    assert(vec_unmap_file(&w) == 0);
+
+    // the Vec still grows after the sync
+    for (i = 3; i < 1000; i++)
+        vec_push(&v, &i);
+    v.len = 0;
+    assert(vec_sync(&v) == 0);
+    assert(file_size() == 0);
+    assert(vec_unmap_file(&v) == 0);
+    unlink(PATH);
+}
+
+static void test_zero_szof(void) {
+    Vec v;
+
+    errno = 0;
+    assert(vec_map_file(&v, 0, PATH, VEC_MAP_WRITE | VEC_MAP_CREATE) == -1);
+    assert(errno == EINVAL);
+}
+
+int main(void) {
+    test_sync_cuts_file();
+    test_zero_szof();
+    puts("test_vec_mmap ok");
+    return 0;
+}
\ No newline at end of file
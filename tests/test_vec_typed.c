@@ -0,0 +1,38 @@
+// typed Vec checks, run by make test
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "vec_typed.h"
+
+typedef struct Point {
+    int x, y;
+} Point;
+
+VEC_DEFINE(IntVec, int)
+VEC_DEFINE(PointVec, Point)
+
+static void test_remove_out_of_bounds(void) {
+    PointVec pv;
+    IntVec v;
+    Point p;
+
+    IntVec_new(&v);
+    IntVec_push(&v, 7);
+    assert(IntVec_remove(&v, 1) == 0);
+    assert(IntVec_len(&v) == 1);
+    assert(IntVec_remove(&v, 0) == 7);
+    assert(IntVec_remove(&v, 0) == 0);
+    IntVec_free(&v);
+
+    PointVec_new(&pv);
+    p = PointVec_remove(&pv, 3);
+    assert(p.x == 0 && p.y == 0);
+    PointVec_free(&pv);
+}
+
+int main(void) {
+    test_remove_out_of_bounds();
+    puts("test_vec_typed ok");
+    return 0;
+}
\ No newline at end of file